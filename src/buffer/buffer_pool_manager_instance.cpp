@@ -209,6 +209,8 @@ bool BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) {
   }
 
   DeallocatePage(page->page_id_);
+  // the frame goes back to the free list, so it must no longer be a candidate victim
+  replacer_->Pin(frame_id);
   page->page_id_ = INVALID_PAGE_ID;
   page->pin_count_ = 0;
   page->is_dirty_ = false;
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -96,6 +97,37 @@ bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
   return res;
 }
 
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                                std::vector<std::vector<ValueType>> *results) {
+  results->clear();
+  results->resize(keys.size());
+
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  // (bucket page_id, index into keys)，按page_id排序后同一个bucket的key相邻
+  std::vector<std::pair<page_id_t, size_t>> targets;
+  targets.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    targets.emplace_back(KeyToPageId(keys[i], dir_page), i);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  std::sort(targets.begin(), targets.end());
+
+  bool res = false;
+  for (size_t i = 0; i < targets.size();) {
+    page_id_t bucket_page_id = targets[i].first;
+    HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+    for (; i < targets.size() && targets[i].first == bucket_page_id; i++) {
+      size_t key_index = targets[i].second;
+      res = bucket_page->GetValue(keys[key_index], comparator_, &(*results)[key_index]) || res;
+    }
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  }
+  table_latch_.RUnlock();
+  return res;
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
@@ -192,6 +224,115 @@ bool HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
   return SplitInsert(transaction, key, value);
 }
 
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::BulkLoad(Transaction *transaction, const std::vector<MappingType> &items) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(0);
+  HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+  bool is_empty = dir_page->GetGlobalDepth() == 0 && bucket_page->IsEmpty();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+
+  // 表非空或者buffer pool不够用时，退化为逐个插入
+  std::vector<MappingType> overflow;
+  const std::vector<MappingType> *rest = &overflow;
+  if (!is_empty || !BulkLoadEmpty(items, &overflow)) {
+    rest = &items;
+  }
+  table_latch_.WUnlock();
+
+  bool res = true;
+  for (const auto &item : *rest) {
+    res = Insert(transaction, item.first, item.second) && res;
+  }
+  return res;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::BulkLoadEmpty(const std::vector<MappingType> &items, std::vector<MappingType> *overflow) {
+  struct Partition {
+    uint32_t prefix_;
+    uint32_t depth_;
+    size_t begin_;
+    size_t end_;
+    page_id_t page_id_;
+  };
+
+  uint32_t max_depth = 0;
+  while ((1U << max_depth) < DIRECTORY_ARRAY_SIZE) {
+    max_depth++;
+  }
+
+  // (hash, index into items)
+  std::vector<std::pair<uint32_t, size_t>> hashes;
+  hashes.reserve(items.size());
+  for (size_t i = 0; i < items.size(); i++) {
+    hashes.emplace_back(Hash(items[i].first), i);
+  }
+
+  // 按hash的低位逐位划分，直到每个分区能放进一个bucket，分区的深度即为bucket的local depth
+  std::vector<Partition> partitions;
+  std::vector<Partition> pending{{0, 0, 0, hashes.size(), INVALID_PAGE_ID}};
+  while (!pending.empty()) {
+    Partition part = pending.back();
+    pending.pop_back();
+    if (part.end_ - part.begin_ <= BUCKET_ARRAY_SIZE || part.depth_ == max_depth) {
+      partitions.push_back(part);
+      continue;
+    }
+    auto mid = std::partition(hashes.begin() + part.begin_, hashes.begin() + part.end_,
+                              [&part](const auto &h) { return ((h.first >> part.depth_) & 1) == 0; });
+    auto mid_pos = static_cast<size_t>(mid - hashes.begin());
+    pending.push_back({part.prefix_, part.depth_ + 1, part.begin_, mid_pos, INVALID_PAGE_ID});
+    pending.push_back({part.prefix_ | (1U << part.depth_), part.depth_ + 1, mid_pos, part.end_, INVALID_PAGE_ID});
+  }
+
+  // 每个bucket page只写一次
+  uint32_t global_depth = 0;
+  for (auto &part : partitions) {
+    Page *p = buffer_pool_manager_->NewPage(&part.page_id_);
+    if (p == nullptr) {
+      for (const auto &created : partitions) {
+        if (created.page_id_ != INVALID_PAGE_ID) {
+          buffer_pool_manager_->DeletePage(created.page_id_);
+        }
+      }
+      return false;
+    }
+    auto *bucket_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(p->GetData());
+    size_t count = std::min<size_t>(part.end_ - part.begin_, BUCKET_ARRAY_SIZE);
+    for (size_t i = 0; i < count; i++) {
+      const MappingType &item = items[hashes[part.begin_ + i].second];
+      bucket_page->InsertAt(i, item.first, item.second);
+    }
+    for (size_t i = part.begin_ + count; i < part.end_; i++) {
+      overflow->push_back(items[hashes[i].second]);
+    }
+    buffer_pool_manager_->UnpinPage(part.page_id_, true);
+    global_depth = std::max(global_depth, part.depth_);
+  }
+
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t old_page_id = dir_page->GetBucketPageId(0);
+  while (dir_page->GetGlobalDepth() < global_depth) {
+    dir_page->IncrGlobalDepth();
+  }
+  // 低depth位等于prefix的目录项都指向该分区的bucket
+  for (const auto &part : partitions) {
+    for (uint32_t i = part.prefix_; i < dir_page->Size(); i += 1U << part.depth_) {
+      dir_page->SetBucketPageId(i, part.page_id_);
+      dir_page->SetLocalDepth(i, part.depth_);
+    }
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+  buffer_pool_manager_->DeletePage(old_page_id);
+  return true;
+}
+
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
@@ -254,6 +395,54 @@ void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const
   buffer_pool_manager_->UnpinPage(directory_page_id_, true);
 }
 
+/*****************************************************************************
+ * ITERATION
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::vector<page_id_t> HASH_TABLE_TYPE::DistinctBucketPageIds(HashTableDirectoryPage *dir_page, uint32_t begin,
+                                                              uint32_t end) {
+  std::vector<page_id_t> bucket_page_ids;
+  for (uint32_t i = begin; i < end; i++) {
+    // 指向同一个bucket的目录项低local depth位相同，只取其中最小的那个
+    if ((i & dir_page->GetLocalDepthMask(i)) == i) {
+      bucket_page_ids.push_back(dir_page->GetBucketPageId(i));
+    }
+  }
+  return bucket_page_ids;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HASH_TABLE_ITERATOR_TYPE HASH_TABLE_TYPE::Begin() {
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  std::vector<page_id_t> bucket_page_ids = DistinctBucketPageIds(dir_page, 0, dir_page->Size());
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return HASH_TABLE_ITERATOR_TYPE(buffer_pool_manager_, &table_latch_, directory_page_id_, std::move(bucket_page_ids));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::vector<HASH_TABLE_ITERATOR_TYPE> HASH_TABLE_TYPE::BeginPartitions(uint32_t num_partitions) {
+  std::vector<std::vector<page_id_t>> partitions;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  uint32_t size = dir_page->Size();
+  for (uint32_t i = 0; i < num_partitions; i++) {
+    uint32_t begin = static_cast<uint64_t>(size) * i / num_partitions;
+    uint32_t end = static_cast<uint64_t>(size) * (i + 1) / num_partitions;
+    partitions.push_back(DistinctBucketPageIds(dir_page, begin, end));
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+
+  std::vector<HASH_TABLE_ITERATOR_TYPE> iterators;
+  iterators.reserve(num_partitions);
+  for (auto &bucket_page_ids : partitions) {
+    iterators.emplace_back(buffer_pool_manager_, &table_latch_, directory_page_id_, std::move(bucket_page_ids));
+  }
+  return iterators;
+}
+
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
  *****************************************************************************/
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table_iterator.cpp
+//
+// Identification: src/container/hash/extendible_hash_table_iterator.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/rid.h"
+#include "container/hash/extendible_hash_table_iterator.h"
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HASH_TABLE_ITERATOR_TYPE::ExtendibleHashTableIterator(BufferPoolManager *buffer_pool_manager,
+                                                      ReaderWriterLatch *table_latch, page_id_t directory_page_id,
+                                                      std::vector<page_id_t> bucket_page_ids)
+    : buffer_pool_manager_(buffer_pool_manager),
+      table_latch_(table_latch),
+      directory_page_id_(directory_page_id),
+      bucket_page_ids_(std::move(bucket_page_ids)) {
+  LoadNextBucket();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_ITERATOR_TYPE::IsEnd() {
+  return item_index_ == items_.size();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+const MappingType &HASH_TABLE_ITERATOR_TYPE::operator*() {
+  return items_[item_index_];
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HASH_TABLE_ITERATOR_TYPE &HASH_TABLE_ITERATOR_TYPE::operator++() {
+  if (++item_index_ == items_.size()) {
+    LoadNextBucket();
+  }
+  return *this;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_ITERATOR_TYPE::LoadNextBucket() {
+  items_.clear();
+  item_index_ = 0;
+  // 跳过空的bucket，直到读到数据或者所有bucket都访问完
+  while (items_.empty() && next_bucket_ < bucket_page_ids_.size()) {
+    page_id_t bucket_page_id = bucket_page_ids_[next_bucket_++];
+    table_latch_->RLock();
+    // a merge since the snapshot may have deleted the bucket page, so only read it if the directory still has it
+    Page *dir_p = buffer_pool_manager_->FetchPage(directory_page_id_);
+    if (dir_p == nullptr) {
+      table_latch_->RUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch directory page");
+    }
+    auto *dir_page = reinterpret_cast<HashTableDirectoryPage *>(dir_p->GetData());
+    bool in_directory = false;
+    for (uint32_t i = 0; i < dir_page->Size() && !in_directory; i++) {
+      in_directory = dir_page->GetBucketPageId(i) == bucket_page_id;
+    }
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    if (!in_directory) {
+      table_latch_->RUnlock();
+      continue;
+    }
+
+    Page *p = buffer_pool_manager_->FetchPage(bucket_page_id);
+    if (p == nullptr) {
+      table_latch_->RUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch bucket page");
+    }
+    auto *bucket_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(p->GetData());
+    for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE; i++) {
+      if (bucket_page->IsReadable(i)) {
+        items_.emplace_back(bucket_page->KeyAt(i), bucket_page->ValueAt(i));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    table_latch_->RUnlock();
+  }
+}
+
+template class ExtendibleHashTableIterator<int, int, IntComparator>;
+
+template class ExtendibleHashTableIterator<GenericKey<4>, RID, GenericComparator<4>>;
+template class ExtendibleHashTableIterator<GenericKey<8>, RID, GenericComparator<8>>;
+template class ExtendibleHashTableIterator<GenericKey<16>, RID, GenericComparator<16>>;
+template class ExtendibleHashTableIterator<GenericKey<32>, RID, GenericComparator<32>>;
+template class ExtendibleHashTableIterator<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -23,46 +24,292 @@
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                      const KeyComparator &comparator, size_t num_buckets,
-                                      HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+LINEAR_PROBE_HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                                   const KeyComparator &comparator, size_t num_buckets,
+                                                   HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  header_page_id_ = CreateLayout(std::max<size_t>(num_buckets, 1));
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HashTableHeaderPage *LINEAR_PROBE_HASH_TABLE_TYPE::FetchHeaderPage(page_id_t header_page_id) {
+  return reinterpret_cast<HashTableHeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HASH_TABLE_BLOCK_TYPE *LINEAR_PROBE_HASH_TABLE_TYPE::FetchBlockPage(page_id_t block_page_id) {
+  return reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(buffer_pool_manager_->FetchPage(block_page_id)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t LINEAR_PROBE_HASH_TABLE_TYPE::CreateLayout(size_t num_buckets) {
+  // the header page has room for a limited number of block page ids
+  num_buckets = std::min(num_buckets, HashTableHeaderPage::MaxNumBlocks() * BLOCK_ARRAY_SIZE);
+  page_id_t header_page_id;
+  Page *p = buffer_pool_manager_->NewPage(&header_page_id);
+  if (p == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "bpm is full");
+  }
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(p->GetData());
+  header_page->SetPageId(header_page_id);
+  header_page->SetSize(num_buckets);
+
+  size_t num_blocks = (num_buckets - 1) / BLOCK_ARRAY_SIZE + 1;
+  for (size_t i = 0; i < num_blocks; i++) {
+    page_id_t block_page_id;
+    if (buffer_pool_manager_->NewPage(&block_page_id) == nullptr) {
+      buffer_pool_manager_->UnpinPage(header_page_id, true);
+      DeleteLayout(header_page_id);
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "bpm is full");
+    }
+    header_page->AddBlockPageId(block_page_id);
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+  }
+
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::DeleteLayout(page_id_t header_page_id) {
+  HashTableHeaderPage *header_page = FetchHeaderPage(header_page_id);
+  std::vector<page_id_t> block_page_ids;
+  for (size_t i = 0; i < header_page->NumBlocks(); i++) {
+    block_page_ids.push_back(header_page->GetBlockPageId(i));
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id, false);
+
+  for (page_id_t block_page_id : block_page_ids) {
+    buffer_pool_manager_->DeletePage(block_page_id);
+  }
+  buffer_pool_manager_->DeletePage(header_page_id);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visitor>
+void LINEAR_PROBE_HASH_TABLE_TYPE::Probe(page_id_t header_page_id, const KeyType &key, Visitor &&visit) {
+  HashTableHeaderPage *header_page = FetchHeaderPage(header_page_id);
+  size_t size = header_page->GetSize();
+  size_t slot = hash_fn_.GetHash(key) % size;
+
+  size_t block_index = slot / BLOCK_ARRAY_SIZE;
+  page_id_t block_page_id = header_page->GetBlockPageId(block_index);
+  HASH_TABLE_BLOCK_TYPE *block_page = FetchBlockPage(block_page_id);
+  bool dirty = false;
+
+  for (size_t i = 0; i < size; i++, slot = (slot + 1) % size) {
+    // 探测跨过了block边界，换到下一个block page
+    if (slot / BLOCK_ARRAY_SIZE != block_index) {
+      buffer_pool_manager_->UnpinPage(block_page_id, dirty);
+      block_index = slot / BLOCK_ARRAY_SIZE;
+      block_page_id = header_page->GetBlockPageId(block_index);
+      block_page = FetchBlockPage(block_page_id);
+      dirty = false;
+    }
+
+    slot_offset_t offset = slot % BLOCK_ARRAY_SIZE;
+    bool occupied = block_page->IsOccupied(offset);
+    if (visit(block_page, offset, &dirty) || !occupied) {
+      break;
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(block_page_id, dirty);
+  buffer_pool_manager_->UnpinPage(header_page_id, false);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool LINEAR_PROBE_HASH_TABLE_TYPE::InsertIntoLayout(page_id_t header_page_id, const KeyType &key,
+                                                    const ValueType &value) {
+  bool inserted = false;
+  Probe(header_page_id, key, [&](HASH_TABLE_BLOCK_TYPE *block_page, slot_offset_t offset, bool *dirty) {
+    if (!block_page->IsOccupied(offset)) {
+      inserted = block_page->Insert(offset, key, value);
+      *dirty = *dirty || inserted;
+      return true;
+    }
+    // 重复的KV对
+    return block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0 &&
+           value == block_page->ValueAt(offset);
+  });
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool LINEAR_PROBE_HASH_TABLE_TYPE::LayoutContains(page_id_t header_page_id, const KeyType &key,
+                                                  const ValueType &value) {
+  bool found = false;
+  Probe(header_page_id, key, [&](HASH_TABLE_BLOCK_TYPE *block_page, slot_offset_t offset, bool *dirty) {
+    found = block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0 &&
+            value == block_page->ValueAt(offset);
+    return found;
+  });
+  return found;
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                            std::vector<ValueType> *result) {
+  table_latch_.RLock();
+  auto collect = [&](HASH_TABLE_BLOCK_TYPE *block_page, slot_offset_t offset, bool *dirty) {
+    if (block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0) {
+      result->push_back(block_page->ValueAt(offset));
+    }
+    return false;
+  };
+  Probe(header_page_id_, key, collect);
+  // 迁移过程中，尚未迁移的KV对还留在旧布局里
+  if (old_header_page_id_ != INVALID_PAGE_ID) {
+    Probe(old_header_page_id_, key, collect);
+  }
+  table_latch_.RUnlock();
+  return !result->empty();
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableHeaderPage *header_page = FetchHeaderPage(header_page_id_);
+  size_t size = header_page->GetSize();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+
+  // 负载因子超过3/4时开始扩容；墓碑较多时以原大小重建即可
+  if (old_header_page_id_ == INVALID_PAGE_ID && (num_occupied_ + 1) * 4 > size * 3) {
+    size_t max_size = HashTableHeaderPage::MaxNumBlocks() * BLOCK_ARRAY_SIZE;
+    size_t new_size = std::min(num_items_ * 2 >= size ? size * 2 : size, max_size);
+    if (new_size > size || (num_occupied_ - num_items_) * 4 > size) {
+      StartResize(new_size);
+    }
+  }
+  if (old_header_page_id_ != INVALID_PAGE_ID) {
+    MigrateStep();
+  }
+
+  bool res = false;
+  if (old_header_page_id_ == INVALID_PAGE_ID || !LayoutContains(old_header_page_id_, key, value)) {
+    res = InsertIntoLayout(header_page_id_, key, value);
+  }
+  if (res) {
+    num_occupied_++;
+    num_items_++;
+  }
+  table_latch_.WUnlock();
+  return res;
 }
 
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  if (old_header_page_id_ != INVALID_PAGE_ID) {
+    MigrateStep();
+  }
+
+  bool res = false;
+  auto remove = [&](HASH_TABLE_BLOCK_TYPE *block_page, slot_offset_t offset, bool *dirty) {
+    if (block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0 &&
+        value == block_page->ValueAt(offset)) {
+      block_page->Remove(offset);
+      *dirty = true;
+      res = true;
+    }
+    return res;
+  };
+  Probe(header_page_id_, key, remove);
+  if (!res && old_header_page_id_ != INVALID_PAGE_ID) {
+    Probe(old_header_page_id_, key, remove);
+  }
+  if (res) {
+    num_items_--;
+  }
+  table_latch_.WUnlock();
+  return res;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void LINEAR_PROBE_HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  table_latch_.WLock();
+  while (old_header_page_id_ != INVALID_PAGE_ID) {
+    MigrateStep();
+  }
+  size_t max_size = HashTableHeaderPage::MaxNumBlocks() * BLOCK_ARRAY_SIZE;
+  StartResize(std::min(std::max({initial_size * 2, num_items_ * 2, static_cast<size_t>(1)}), max_size));
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::StartResize(size_t num_buckets) {
+  old_header_page_id_ = header_page_id_;
+  header_page_id_ = CreateLayout(num_buckets);
+  migrate_index_ = 0;
+  num_occupied_ = 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::MigrateStep() {
+  HashTableHeaderPage *old_header_page = FetchHeaderPage(old_header_page_id_);
+  size_t old_size = old_header_page->GetSize();
+  page_id_t block_page_id = old_header_page->GetBlockPageId(migrate_index_ / BLOCK_ARRAY_SIZE);
+  HASH_TABLE_BLOCK_TYPE *block_page = FetchBlockPage(block_page_id);
+  buffer_pool_manager_->UnpinPage(old_header_page_id_, false);
+
+  // 每次迁移旧布局中的一个block
+  size_t end = std::min(migrate_index_ + BLOCK_ARRAY_SIZE, old_size);
+  for (size_t slot = migrate_index_; slot < end; slot++) {
+    slot_offset_t offset = slot % BLOCK_ARRAY_SIZE;
+    if (!block_page->IsReadable(offset)) {
+      continue;
+    }
+    if (!InsertIntoLayout(header_page_id_, block_page->KeyAt(offset), block_page->ValueAt(offset))) {
+      buffer_pool_manager_->UnpinPage(block_page_id, true);
+      throw Exception(ExceptionType::OUT_OF_RANGE, "no free slot left while migrating hash table");
+    }
+    block_page->Remove(offset);
+    num_occupied_++;
+  }
+  buffer_pool_manager_->UnpinPage(block_page_id, true);
+
+  migrate_index_ = end;
+  if (migrate_index_ == old_size) {
+    DeleteLayout(old_header_page_id_);
+    old_header_page_id_ = INVALID_PAGE_ID;
+    migrate_index_ = 0;
+  }
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-size_t HASH_TABLE_TYPE::GetSize() {
-  return 0;
+size_t LINEAR_PROBE_HASH_TABLE_TYPE::GetSize() {
+  table_latch_.RLock();
+  HashTableHeaderPage *header_page = FetchHeaderPage(header_page_id_);
+  size_t size = header_page->GetSize();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return size;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool LINEAR_PROBE_HASH_TABLE_TYPE::IsResizing() {
+  table_latch_.RLock();
+  bool res = old_header_page_id_ != INVALID_PAGE_ID;
+  table_latch_.RUnlock();
+  return res;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
@@ -9,7 +9,9 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <exception>
 #include <memory>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "execution/executors/aggregation_executor.h"
@@ -25,28 +27,89 @@ AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const Aggreg
       aht_iterator_(aht_.Begin()) {}
 
 void AggregationExecutor::Init() {
-  Tuple tuple;
-  RID rid;
-
   child_->Init();
-  while (child_->Next(&tuple, &rid)) {
-    aht_.InsertCombine(MakeAggregateKey(&tuple), MakeAggregateValue(&tuple));
+
+  auto *scan = dynamic_cast<SeqScanExecutor *>(child_.get());
+  if (scan != nullptr && scan->GetParallelism() > 1) {
+    AggregateInParallel(scan);
+  } else {
+    TupleBatch batch;
+    while (child_->NextBatch(&batch)) {
+      AggregateBatch(batch, &aht_);
+    }
   }
   aht_iterator_ = aht_.Begin();
 }
 
+void AggregationExecutor::AggregateBatch(const TupleBatch &batch, SimpleAggregationHashTable *aht) {
+  const auto &group_by_exprs = plan_->GetGroupBys();
+  const auto &aggregate_exprs = plan_->GetAggregates();
+  std::vector<std::vector<Value>> group_bys(group_by_exprs.size());
+  std::vector<std::vector<Value>> aggregates(aggregate_exprs.size());
+
+  /* evaluate the group-bys and aggregates a column at a time, then combine row by row */
+  for (uint32_t i = 0; i < group_by_exprs.size(); i++) {
+    group_by_exprs[i]->EvaluateBatch(batch, &group_bys[i]);
+  }
+  for (uint32_t i = 0; i < aggregate_exprs.size(); i++) {
+    aggregate_exprs[i]->EvaluateBatch(batch, &aggregates[i]);
+  }
+  for (uint32_t row = 0; row < batch.Size(); row++) {
+    AggregateKey key;
+    key.group_bys_.reserve(group_bys.size());
+    for (const auto &column : group_bys) {
+      key.group_bys_.push_back(column[row]);
+    }
+    AggregateValue value;
+    value.aggregates_.reserve(aggregates.size());
+    for (const auto &column : aggregates) {
+      value.aggregates_.push_back(column[row]);
+    }
+    aht->InsertCombine(key, value);
+  }
+}
+
+void AggregationExecutor::AggregateInParallel(SeqScanExecutor *scan) {
+  std::size_t num_workers = scan->GetParallelism();
+  std::vector<SimpleAggregationHashTable> partials;
+  partials.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; i++) {
+    partials.emplace_back(plan_->GetAggregates(), plan_->GetAggregateTypes());
+  }
+  std::vector<std::exception_ptr> errors(num_workers);
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < num_workers; i++) {
+    workers.emplace_back([&, i] {
+      try {
+        TupleBatch batch;
+        while (scan->NextMorsel(&batch)) {
+          AggregateBatch(batch, &partials[i]);
+        }
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  /* the pipeline breaker: merge the partial aggregates */
+  for (const auto &partial : partials) {
+    aht_.Merge(partial);
+  }
+}
+
 bool AggregationExecutor::Next(Tuple *tuple, RID *rid) {
   while (aht_iterator_ != aht_.End()) {
-    if (plan_->GetHaving() == nullptr ||
-        plan_->GetHaving()
-            ->EvaluateAggregate(aht_iterator_.Key().group_bys_, aht_iterator_.Val().aggregates_)
-            .GetAs<bool>()) {
-      std::vector<Value> values;
-      for (auto &output_column : plan_->OutputSchema()->GetColumns()) {
-        values.push_back(output_column.GetExpr()->EvaluateAggregate(aht_iterator_.Key().group_bys_,
-                                                                    aht_iterator_.Val().aggregates_));
-      }
-      *tuple = Tuple(values, plan_->OutputSchema());
+    if (MatchesHaving()) {
+      *tuple = Tuple(MakeOutputValues(), plan_->OutputSchema());
       ++aht_iterator_;
       return true;
     }
@@ -56,6 +119,18 @@ bool AggregationExecutor::Next(Tuple *tuple, RID *rid) {
   return false;
 }
 
+bool AggregationExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset(plan_->OutputSchema());
+  while (aht_iterator_ != aht_.End() && !batch->IsFull()) {
+    if (MatchesHaving()) {
+      batch->AppendRow(MakeOutputValues(), RID());
+    }
+    ++aht_iterator_;
+  }
+
+  return !batch->IsEmpty();
+}
+
 const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
 
 }  // namespace bustub
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter.cpp
+//
+// Identification: src/execution/bloom_filter.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+
+#include "execution/bloom_filter.h"
+#include "type/value.h"
+
+namespace bustub {
+
+namespace {
+
+/** Odd multipliers that spread a 32-bit hash over the bit positions of the eight words of a block */
+constexpr std::array<uint32_t, 8> SALTS = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                           0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+}  // namespace
+
+BloomFilter::BloomFilter(std::size_t num_keys)
+    : blocks_(std::max<std::size_t>(1, (num_keys * BITS_PER_KEY + 8 * sizeof(Block) - 1) / (8 * sizeof(Block)))) {}
+
+BloomFilter::Block BloomFilter::GetMask(hash_t hash) {
+  Block mask;
+  auto key = static_cast<uint32_t>(hash);
+  for (std::size_t i = 0; i < mask.size(); i++) {
+    mask[i] = 1U << ((key * SALTS[i]) >> 27);
+  }
+  return mask;
+}
+
+void BloomFilter::Insert(hash_t hash) {
+  Block &block = blocks_[GetBlockIdx(hash)];
+  Block mask = GetMask(hash);
+  for (std::size_t i = 0; i < block.size(); i++) {
+    block[i] |= mask[i];
+  }
+}
+
+bool BloomFilter::MayContain(hash_t hash) const {
+  const Block &block = blocks_[GetBlockIdx(hash)];
+  Block mask = GetMask(hash);
+  for (std::size_t i = 0; i < block.size(); i++) {
+    if ((block[i] & mask[i]) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BloomTupleFilter::Matches(const char *data) const {
+  /* find the value as Tuple::GetDataPtr() does */
+  const char *value_data = data + column_.GetOffset();
+  if (!column_.IsInlined()) {
+    int32_t offset;
+    memcpy(&offset, value_data, sizeof(int32_t));
+    value_data = data + offset;
+  }
+  Value value = Value::DeserializeFrom(value_data, column_.GetType());
+  if (!bloom_filter_->MayContain(HashUtil::HashValue(&value))) {
+    return false;
+  }
+  return next_ == nullptr || next_->Matches(data);
+}
+
+}  // namespace bustub
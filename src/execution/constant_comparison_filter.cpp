@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// constant_comparison_filter.cpp
+//
+// Identification: src/execution/constant_comparison_filter.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/constant_comparison_filter.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+/** The comparison that gives the same result with its operands swapped, e.g. `>` for `<`. */
+ComparisonType Mirror(ComparisonType comp_type) {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+template <typename T>
+std::unique_ptr<TupleFilter> MakeFilter(uint32_t offset, ComparisonType comp_type, const Value &constant,
+                                        T null_value) {
+  return std::make_unique<ConstantComparisonFilter<T>>(offset, comp_type, constant.GetAs<T>(), null_value);
+}
+
+}  // namespace
+
+std::unique_ptr<TupleFilter> MakeConstantComparisonFilter(const AbstractExpression *predicate, const Schema *schema) {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(predicate);
+  if (comparison == nullptr) {
+    return nullptr;
+  }
+
+  ComparisonType comp_type = comparison->GetComparisonType();
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0));
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1));
+  if (column == nullptr && constant == nullptr) {
+    column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1));
+    constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0));
+    comp_type = Mirror(comp_type);
+  }
+  if (column == nullptr || constant == nullptr || column->GetColIdx() >= schema->GetColumnCount()) {
+    return nullptr;
+  }
+
+  const Column &col = schema->GetColumn(column->GetColIdx());
+  const Value &value = constant->GetValue();
+  if (value.IsNull() || value.GetTypeId() != col.GetType()) {
+    return nullptr;
+  }
+  uint32_t offset = col.GetOffset();
+  switch (col.GetType()) {
+    case TypeId::BOOLEAN:
+      return MakeFilter<int8_t>(offset, comp_type, value, BUSTUB_BOOLEAN_NULL);
+    case TypeId::TINYINT:
+      return MakeFilter<int8_t>(offset, comp_type, value, BUSTUB_INT8_NULL);
+    case TypeId::SMALLINT:
+      return MakeFilter<int16_t>(offset, comp_type, value, BUSTUB_INT16_NULL);
+    case TypeId::INTEGER:
+      return MakeFilter<int32_t>(offset, comp_type, value, BUSTUB_INT32_NULL);
+    case TypeId::BIGINT:
+      return MakeFilter<int64_t>(offset, comp_type, value, BUSTUB_INT64_NULL);
+    case TypeId::DECIMAL:
+      return MakeFilter<double>(offset, comp_type, value, BUSTUB_DECIMAL_NULL);
+    case TypeId::TIMESTAMP:
+      return MakeFilter<uint64_t>(offset, comp_type, value, BUSTUB_TIMESTAMP_NULL);
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace bustub
@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <utility>
+#include <vector>
+
 #include "execution/executors/distinct_executor.h"
 #include "execution/plans/distinct_plan.h"
 
@@ -38,4 +41,28 @@ bool DistinctExecutor::Next(Tuple *tuple, RID *rid) {
   }
 }
 
+bool DistinctExecutor::NextBatch(TupleBatch *batch) {
+  uint32_t column_cnt = child_executor_->GetOutputSchema()->GetColumnCount();
+
+  while (child_executor_->NextBatch(batch)) {
+    std::vector<uint32_t> selection;
+    for (uint32_t row : batch->GetSelection()) {
+      DistinctKey key;
+      key.values_.reserve(column_cnt);
+      for (uint32_t i = 0; i < column_cnt; i++) {
+        key.values_.push_back(batch->GetValue(i, row));
+      }
+      if (us_.insert(std::move(key)).second) {
+        selection.push_back(row);
+      }
+    }
+    batch->Select(std::move(selection));
+    if (!batch->IsEmpty()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 }  // namespace bustub
@@ -10,6 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "execution/executors/hash_join_executor.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/plans/hash_join_plan.h"
@@ -31,48 +36,367 @@ void HashJoinExecutor::Init() {
   RID rid;
 
   left_executor_->Init();
-  right_executor_->Init();
 
-  ht_.clear();
+  partitions_.clear();
+  partitions_.resize(SPILL_PARTITIONS);
+  memory_used_ = 0;
+  spilled_.clear();
 
   column_cnt_ = plan_->OutputSchema()->GetColumnCount();
+  left_or_right_.clear();
   for (uint32_t i = 0; i < column_cnt_; i++) {
     left_or_right_.push_back(
         static_cast<const ColumnValueExpression *>(plan_->OutputSchema()->GetColumn(i).GetExpr())->GetTupleIdx());
   }
 
-  while (left_executor_->Next(&tuple, &rid)) {
-    HashJoinKey left_key = GetLeftJoinKey(&tuple);
-    if (ht_.find(left_key) == ht_.end()) {
-      ht_.insert({left_key, std::vector<Tuple>()});
+  /* a right key that is a column of the right child can be checked by it against a Bloom filter of the left keys, */
+  /* so that the right rows without a match are dropped in the scan; the hashes agree only if the types do */
+  const auto *right_key = dynamic_cast<const ColumnValueExpression *>(plan_->RightJoinKeyExpression());
+  bool push_down =
+      right_key != nullptr && right_key->GetReturnType() == plan_->LeftJoinKeyExpression()->GetReturnType();
+  std::vector<hash_t> left_hashes;
+
+  radix_left_.clear();
+  radix_right_.clear();
+  radix_left_keys_.clear();
+  radix_right_keys_.clear();
+  radix_join_.reset();
+  radix_matches_.clear();
+  radix_ = GetExecutorContext()->GetParallelism() > 1 && GetExecutorContext()->GetMemoryBudget() == 0;
+  std::vector<Value> left_keys;
+  std::vector<RadixJoin::Entry> left_entries;
+  if (radix_) {
+    Materialize(left_executor_.get(), plan_->LeftJoinKeyExpression(), &radix_left_, &left_keys, &left_entries);
+    if (push_down) {
+      for (const auto &entry : left_entries) {
+        left_hashes.push_back(entry.hash_);
+      }
+    }
+  } else {
+    while (left_executor_->Next(&tuple, &rid)) {
+      HashJoinKey key = GetLeftJoinKey(&tuple);
+      if (push_down) {
+        left_hashes.push_back(HashUtil::HashValue(&key.value_));
+      }
+      Build(key, tuple);
+    }
+  }
+
+  if (push_down) {
+    auto filter = std::make_shared<BloomFilter>(left_hashes.size());
+    for (hash_t hash : left_hashes) {
+      filter->Insert(hash);
+    }
+    right_executor_->PushDownBloomFilter(right_key->GetColIdx(), std::move(filter));
+  }
+  right_executor_->Init();
+
+  if (radix_) {
+    RadixInit(std::move(left_keys), std::move(left_entries));
+    return;
+  }
+
+  /* the right side is probed as the output is pulled, by whichever of Next() and NextBatch() is called */
+  right_done_ = false;
+  joining_ = nullptr;
+  spill_idx_ = 0;
+  spill_page_ = 0;
+  spill_tuples_.clear();
+  spill_tuple_idx_ = 0;
+  probe_keys_.clear();
+  probe_columns_.assign(column_cnt_, std::vector<Value>());
+  probe_row_ = 0;
+  match_row_ = 0;
+  matches_ = nullptr;
+  match_idx_ = 0;
+}
+
+bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  if (radix_) {
+    const Tuple *left_tuple;
+    const Tuple *right_tuple;
+    if (!NextRadixMatch(&left_tuple, &right_tuple)) {
+      return false;
+    }
+    *tuple = Tuple(MakeOutputValues(*left_tuple, *right_tuple), plan_->OutputSchema());
+    return true;
+  }
+
+  while (matches_ == nullptr || match_idx_ == matches_->size()) {
+    HashJoinKey key;
+    matches_ = nullptr;
+    if (!NextRightTuple(&key)) {
+      return false;
+    }
+    matches_ = FindMatches(key);
+    match_idx_ = 0;
+  }
+
+  *tuple = Tuple(MakeOutputValues((*matches_)[match_idx_++], right_tuple_), plan_->OutputSchema());
+  return true;
+}
+
+bool HashJoinExecutor::NextBatch(TupleBatch *batch) {
+  if (radix_) {
+    batch->Reset(plan_->OutputSchema());
+    const Tuple *left_tuple;
+    const Tuple *right_tuple;
+    while (!batch->IsFull() && NextRadixMatch(&left_tuple, &right_tuple)) {
+      batch->AppendRow(MakeOutputValues(*left_tuple, *right_tuple), RID());
     }
-    ht_[left_key].push_back(tuple);
+    return !batch->IsEmpty();
   }
 
-  while (right_executor_->Next(&tuple, &rid)) {
-    HashJoinKey right_key = GetRightJoinKey(&tuple);
-    if (ht_.find(right_key) != ht_.end()) {
-      for (Tuple &left_tuple : ht_[right_key]) {
-        std::vector<Value> values;
-        for (uint32_t i = 0; i < column_cnt_; i++) {
-          values.push_back(plan_->OutputSchema()->GetColumn(i).GetExpr()->Evaluate(
-              left_or_right_[i] == 0 ? &left_tuple : &tuple,
-              left_or_right_[i] == 0 ? plan_->GetLeftPlan()->OutputSchema() : plan_->GetRightPlan()->OutputSchema()));
+  const Schema *left_schema = plan_->GetLeftPlan()->OutputSchema();
+  std::vector<Value> values(column_cnt_);
+
+  batch->Reset(plan_->OutputSchema());
+  while (!batch->IsFull()) {
+    if (matches_ != nullptr && match_idx_ < matches_->size()) {
+      const Tuple &left_tuple = (*matches_)[match_idx_++];
+      for (uint32_t i = 0; i < column_cnt_; i++) {
+        values[i] = left_or_right_[i] == 0
+                        ? plan_->OutputSchema()->GetColumn(i).GetExpr()->Evaluate(&left_tuple, left_schema)
+                        : probe_columns_[i][match_row_];
+      }
+      batch->AppendRow(values, RID());
+      continue;
+    }
+
+    /* move on to the next right row, fetching and evaluating the next right batch if this one is done */
+    matches_ = nullptr;
+    bool exhausted = false;
+    while (probe_row_ == probe_keys_.size()) {
+      if (!NextRightBatch()) {
+        exhausted = true;
+        break;
+      }
+      for (uint32_t i = 0; i < column_cnt_; i++) {
+        if (left_or_right_[i] != 0) {
+          plan_->OutputSchema()->GetColumn(i).GetExpr()->EvaluateBatch(probe_batch_, &probe_columns_[i]);
         }
-        res_.emplace_back(Tuple(values, plan_->OutputSchema()));
       }
+      probe_row_ = 0;
+    }
+    if (exhausted) {
+      break;
     }
+    match_row_ = probe_row_++;
+    matches_ = FindMatches(HashJoinKey{probe_keys_[match_row_]});
+    match_idx_ = 0;
   }
 
-  res_iterator_ = res_.begin();
+  return !batch->IsEmpty();
 }
 
-bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) {
-  if (res_iterator_ == res_.end()) {
-    return false;
+void HashJoinExecutor::Build(const HashJoinKey &key, const Tuple &tuple) {
+  Partition *part = GetPartition(key);
+  if (part->left_file_ != nullptr) {
+    part->left_file_->Append(tuple);
+    return;
+  }
+
+  part->ht_[key].push_back(tuple);
+  std::size_t size = sizeof(Tuple) + tuple.GetLength();
+  part->size_ += size;
+  memory_used_ += size;
+
+  std::size_t budget = GetExecutorContext()->GetMemoryBudget();
+  while (budget != 0 && memory_used_ > budget) {
+    SpillLargestPartition();
+  }
+}
+
+void HashJoinExecutor::SpillLargestPartition() {
+  Partition *victim = nullptr;
+  for (auto &part : partitions_) {
+    if (part.left_file_ == nullptr && (victim == nullptr || part.size_ > victim->size_)) {
+      victim = &part;
+    }
+  }
+
+  BufferPoolManager *bpm = GetExecutorContext()->GetBufferPoolManager();
+  victim->left_file_ = std::make_unique<TmpTupleFile>(bpm);
+  victim->right_file_ = std::make_unique<TmpTupleFile>(bpm);
+  for (const auto &entry : victim->ht_) {
+    for (const Tuple &tuple : entry.second) {
+      victim->left_file_->Append(tuple);
+    }
   }
-  *tuple = *res_iterator_++;
+  memory_used_ -= victim->size_;
+  victim->ht_ = std::unordered_map<HashJoinKey, std::vector<Tuple>>();
+  victim->size_ = 0;
+  spilled_.push_back(victim);
+}
+
+const std::vector<Tuple> *HashJoinExecutor::FindMatches(const HashJoinKey &key) {
+  const auto &ht = GetPartition(key)->ht_;
+  auto it = ht.find(key);
+  return it == ht.end() ? nullptr : &it->second;
+}
+
+bool HashJoinExecutor::NextRightTuple(HashJoinKey *key) {
+  RID rid;
+  while (!right_done_ && right_executor_->Next(&right_tuple_, &rid)) {
+    *key = GetRightJoinKey(&right_tuple_);
+    Partition *part = GetPartition(*key);
+    if (part->right_file_ == nullptr) {
+      return true;
+    }
+    part->right_file_->Append(right_tuple_);
+  }
+  right_done_ = true;
+
+  while (spill_tuple_idx_ == spill_tuples_.size()) {
+    if (!NextSpilledPage()) {
+      return false;
+    }
+  }
+  right_tuple_ = spill_tuples_[spill_tuple_idx_++];
+  *key = GetRightJoinKey(&right_tuple_);
+  return true;
+}
+
+bool HashJoinExecutor::NextRightBatch() {
+  if (!right_done_ && right_executor_->NextBatch(&probe_batch_)) {
+    plan_->RightJoinKeyExpression()->EvaluateBatch(probe_batch_, &probe_keys_);
+    if (spilled_.empty()) {
+      return true;
+    }
+
+    /* spill the rows of spilled partitions and probe with the rest */
+    std::vector<uint32_t> selection;
+    std::vector<Value> keys;
+    for (std::size_t i = 0; i < probe_keys_.size(); i++) {
+      uint32_t row = probe_batch_.GetSelection()[i];
+      Partition *part = GetPartition(HashJoinKey{probe_keys_[i]});
+      if (part->right_file_ != nullptr) {
+        part->right_file_->Append(probe_batch_.GetTuple(row));
+      } else {
+        selection.push_back(row);
+        keys.push_back(std::move(probe_keys_[i]));
+      }
+    }
+    probe_batch_.Select(std::move(selection));
+    probe_keys_ = std::move(keys);
+    return true;
+  }
+  right_done_ = true;
+
+  /* a batch holds the tuples of one page of a spilled partition at most, since the partition is dropped after it */
+  while (spill_tuple_idx_ == spill_tuples_.size()) {
+    if (!NextSpilledPage()) {
+      return false;
+    }
+  }
+  probe_batch_.Reset(right_executor_->GetOutputSchema());
+  while (!probe_batch_.IsFull() && spill_tuple_idx_ < spill_tuples_.size()) {
+    probe_batch_.AppendTuple(spill_tuples_[spill_tuple_idx_++], RID());
+  }
+  plan_->RightJoinKeyExpression()->EvaluateBatch(probe_batch_, &probe_keys_);
   return true;
 }
 
+bool HashJoinExecutor::NextSpilledPage() {
+  while (joining_ == nullptr || spill_page_ == joining_->right_file_->GetPageCount()) {
+    if (joining_ != nullptr) {
+      *joining_ = Partition();
+      joining_ = nullptr;
+    }
+    if (spill_idx_ == spilled_.size()) {
+      return false;
+    }
+
+    /* load the left tuples of the next spilled partition, unless no right tuple went to it */
+    joining_ = spilled_[spill_idx_++];
+    spill_page_ = 0;
+    if (joining_->right_file_->GetPageCount() == 0) {
+      continue;
+    }
+    for (std::size_t i = 0; i < joining_->left_file_->GetPageCount(); i++) {
+      joining_->left_file_->ReadPage(i, &spill_tuples_);
+      for (const Tuple &tuple : spill_tuples_) {
+        joining_->ht_[GetLeftJoinKey(&tuple)].push_back(tuple);
+      }
+    }
+  }
+
+  joining_->right_file_->ReadPage(spill_page_++, &spill_tuples_);
+  spill_tuple_idx_ = 0;
+  return true;
+}
+
+std::vector<Value> HashJoinExecutor::MakeOutputValues(const Tuple &left_tuple, const Tuple &right_tuple) const {
+  std::vector<Value> values;
+  values.reserve(column_cnt_);
+  for (uint32_t i = 0; i < column_cnt_; i++) {
+    values.push_back(plan_->OutputSchema()->GetColumn(i).GetExpr()->Evaluate(
+        left_or_right_[i] == 0 ? &left_tuple : &right_tuple,
+        left_or_right_[i] == 0 ? plan_->GetLeftPlan()->OutputSchema() : plan_->GetRightPlan()->OutputSchema()));
+  }
+  return values;
+}
+
+void HashJoinExecutor::RadixInit(std::vector<Value> left_keys, std::vector<RadixJoin::Entry> left_entries) {
+  std::vector<Value> right_keys;
+  std::vector<RadixJoin::Entry> right_entries;
+  Materialize(right_executor_.get(), plan_->RightJoinKeyExpression(), &radix_right_, &right_keys, &right_entries);
+
+  radix_left_keys_ = std::move(left_keys);
+  radix_right_keys_ = std::move(right_keys);
+  radix_join_ = std::make_unique<RadixJoin>(GetExecutorContext()->GetParallelism());
+  radix_join_->Partition(std::move(left_entries), std::move(right_entries));
+  radix_next_partition_ = 0;
+  radix_matches_.clear();
+  radix_partition_ = 0;
+  radix_match_ = 0;
+}
+
+void HashJoinExecutor::Materialize(AbstractExecutor *child, const AbstractExpression *key_expr,
+                                   std::vector<Tuple> *tuples, std::vector<Value> *keys,
+                                   std::vector<RadixJoin::Entry> *entries) {
+  TupleBatch batch;
+  std::vector<Value> batch_keys;
+  while (child->NextBatch(&batch)) {
+    key_expr->EvaluateBatch(batch, &batch_keys);
+    for (uint32_t i = 0; i < batch.Size(); i++) {
+      entries->push_back({HashUtil::HashValue(&batch_keys[i]), static_cast<uint32_t>(tuples->size())});
+      tuples->push_back(batch.GetTuple(batch.GetSelection()[i]));
+      keys->push_back(std::move(batch_keys[i]));
+    }
+  }
+}
+
+bool HashJoinExecutor::NextRadixMatch(const Tuple **left_tuple, const Tuple **right_tuple) {
+  while (true) {
+    while (radix_partition_ < radix_matches_.size()) {
+      const auto &matches = radix_matches_[radix_partition_];
+      if (radix_match_ < matches.size()) {
+        auto [left_idx, right_idx] = matches[radix_match_++];
+        *left_tuple = &radix_left_[left_idx];
+        *right_tuple = &radix_right_[right_idx];
+        return true;
+      }
+      radix_partition_++;
+      radix_match_ = 0;
+    }
+
+    /* join the next partitions, one per thread */
+    std::size_t num_partitions = radix_join_->GetPartitionCount();
+    if (radix_next_partition_ == num_partitions) {
+      return false;
+    }
+    std::size_t count = std::min(GetExecutorContext()->GetParallelism(), num_partitions - radix_next_partition_);
+    radix_join_->JoinPartitions(radix_next_partition_, count,
+                                [this](uint32_t left_idx, uint32_t right_idx) {
+                                  return radix_left_keys_[left_idx].CompareEquals(radix_right_keys_[right_idx]) ==
+                                         CmpBool::CmpTrue;
+                                },
+                                &radix_matches_);
+    radix_next_partition_ += count;
+    radix_partition_ = 0;
+    radix_match_ = 0;
+  }
+}
+
 }  // namespace bustub
@@ -11,12 +11,106 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include <memory>
+#include <utility>
+
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "execution/expressions/column_value_expression.h"
+#include "storage/index/b_plus_tree_index.h"
+
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexScanExecutor::Init() {
+  IndexInfo *index_info = exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid());
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(index_info->table_name_);
+
+  filter_.reset();
+  if (bloom_filter_ != nullptr) {
+    filter_ = std::make_unique<BloomTupleFilter>(bloom_filter_, table_info_->schema_.GetColumn(bloom_column_));
+  }
+
+  Index *index = index_info->index_.get();
+  if (!InitScan<4>(index) && !InitScan<8>(index) && !InitScan<16>(index) && !InitScan<32>(index) &&
+      !InitScan<64>(index)) {
+    throw NotImplementedException("index scans need a B+ tree index");
+  }
+}
+
+template <size_t KeySize>
+bool IndexScanExecutor::InitScan(Index *index) {
+  auto *tree_index = dynamic_cast<BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>> *>(index);
+  if (tree_index == nullptr) {
+    return false;
+  }
+  const auto &low_key = plan_->GetLowKey();
+  const auto &high_key = plan_->GetHighKey();
+  // the iterator stops at the far bound, so the scan never reads leaves past the range
+  auto iterator = std::make_shared<IndexIterator<GenericKey<KeySize>, RID, GenericComparator<KeySize>>>(
+      tree_index->GetRangeIterator(low_key.has_value() ? &*low_key : nullptr,
+                                   high_key.has_value() ? &*high_key : nullptr, plan_->IsReverse(),
+                                   INDEX_SCAN_READ_AHEAD));
+  next_rid_ = [iterator](RID *rid) {
+    if (iterator->IsEnd()) {
+      return false;
+    }
+    *rid = (**iterator).second;
+    ++*iterator;
+    return true;
+  };
+  return true;
+}
+
+bool IndexScanExecutor::PushDownBloomFilter(uint32_t col_idx, std::shared_ptr<const BloomFilter> filter) {
+  const auto *column =
+      dynamic_cast<const ColumnValueExpression *>(plan_->OutputSchema()->GetColumn(col_idx).GetExpr());
+  if (column == nullptr) {
+    return false;
+  }
+  bloom_filter_ = std::move(filter);
+  bloom_column_ = column->GetColIdx();
+  return true;
+}
+
+bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) {
+  Transaction *txn = exec_ctx_->GetTransaction();
+
+  while (next_rid_(rid)) {
+    if (filter_ != nullptr && !table_info_->table_->TupleMatches(*rid, *filter_)) {
+      continue;
+    }
+
+    if ((!txn->IsExclusiveLocked(*rid) && !txn->IsSharedLocked(*rid)) &&
+        txn->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED) {
+      exec_ctx_->GetLockManager()->LockShared(txn, *rid);
+    }
+
+    bool found = table_info_->table_->GetTuple(*rid, tuple, txn);
+
+    if (txn->GetIsolationLevel() == IsolationLevel::READ_COMMITTED && txn->IsSharedLocked(*rid)) {
+      exec_ctx_->GetLockManager()->Unlock(txn, *rid);
+    }
+
+    // the tuple may have been deleted since the index entry was read
+    if (!found) {
+      continue;
+    }
+    if ((plan_->GetPredicate() == nullptr) ||
+        plan_->GetPredicate()->Evaluate(tuple, &table_info_->schema_).GetAs<bool>()) {
+      std::vector<Value> values;
+      for (auto &output_column : plan_->OutputSchema()->GetColumns()) {
+        values.push_back(output_column.GetExpr()->Evaluate(tuple, &table_info_->schema_));
+      }
+
+      *tuple = Tuple(values, plan_->OutputSchema());
 
-void IndexScanExecutor::Init() {}
+      return true;
+    }
+  }
 
-bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+  return false;
+}
 
 }  // namespace bustub
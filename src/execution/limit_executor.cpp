@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "execution/executors/limit_executor.h"
 
 namespace bustub {
@@ -35,4 +37,15 @@ bool LimitExecutor::Next(Tuple *tuple, RID *rid) {
   return true;
 }
 
+bool LimitExecutor::NextBatch(TupleBatch *batch) {
+  if (cur_limit_ >= plan_->GetLimit() || !child_executor_->NextBatch(batch)) {
+    return false;
+  }
+
+  std::size_t size = std::min<std::size_t>(batch->Size(), plan_->GetLimit() - cur_limit_);
+  batch->Truncate(size);
+  cur_limit_ += size;
+  return true;
+}
+
 }  // namespace bustub
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "execution/executors/nested_loop_join_executor.h"
 #include "execution/expressions/column_value_expression.h"
 
@@ -22,51 +24,75 @@ NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const
       plan_(plan),
       left_executor_(std::move(left_executor)),
       right_executor_(std::move(right_executor)),
-      is_dummy_left_(true) {}
+      block_count_(0),
+      has_right_(false),
+      left_idx_(0) {}
 
 void NestedLoopJoinExecutor::Init() {
   left_executor_->Init();
   right_executor_->Init();
-  is_dummy_left_ = true;
+  left_block_.clear();
+  block_count_ = 0;
+  has_right_ = false;
+  left_idx_ = 0;
 
   column_cnt_ = plan_->OutputSchema()->GetColumnCount();
+  left_or_right_.clear();
   for (uint32_t i = 0; i < column_cnt_; i++) {
     left_or_right_.push_back(
         static_cast<const ColumnValueExpression *>(plan_->OutputSchema()->GetColumn(i).GetExpr())->GetTupleIdx());
   }
 }
 
-bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) {
-  Tuple right_tuple;
-
-  /* enter upon first Next() invocation */
-  if (is_dummy_left_) {
-    if (!left_executor_->Next(&cur_left_, rid)) {
-      return false;
-    }
-    is_dummy_left_ = false;
+bool NestedLoopJoinExecutor::NextLeftBlock() {
+  left_block_.clear();
+  std::size_t block_size = std::max<std::size_t>(plan_->GetBlockPages(), 1) * PAGE_SIZE;
+  std::size_t size = 0;
+  Tuple tuple;
+  RID rid;
+  while (size < block_size && left_executor_->Next(&tuple, &rid)) {
+    size += tuple.GetLength();
+    left_block_.push_back(tuple);
+  }
+  if (left_block_.empty()) {
+    return false;
+  }
+  /* the right side was initialized for the first block by Init() */
+  if (block_count_++ > 0) {
+    right_executor_->Init();
   }
+  return true;
+}
+
+bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  const Schema *left_schema = left_executor_->GetOutputSchema();
+  const Schema *right_schema = right_executor_->GetOutputSchema();
 
   while (true) {
-    if (!right_executor_->Next(&right_tuple, rid)) {
-      if (!left_executor_->Next(&cur_left_, rid)) {
-        return false;
-      }
-      right_executor_->Init();
-    } else {
-      if ((plan_->Predicate() == nullptr) || plan_->Predicate()
-                                                 ->EvaluateJoin(&cur_left_, left_executor_->GetOutputSchema(),
-                                                                &right_tuple, right_executor_->GetOutputSchema())
-                                                 .GetAs<bool>()) {
-        std::vector<Value> values;
-        for (uint32_t i = 0; i < column_cnt_; i++) {
-          values.push_back(plan_->OutputSchema()->GetColumn(i).GetExpr()->Evaluate(
-              left_or_right_[i] == 0 ? &cur_left_ : &right_tuple,
-              left_or_right_[i] == 0 ? plan_->GetLeftPlan()->OutputSchema() : plan_->GetRightPlan()->OutputSchema()));
+    if (has_right_) {
+      while (left_idx_ < left_block_.size()) {
+        const Tuple &left_tuple = left_block_[left_idx_++];
+        if ((plan_->Predicate() == nullptr) ||
+            plan_->Predicate()->EvaluateJoin(&left_tuple, left_schema, &right_tuple_, right_schema).GetAs<bool>()) {
+          std::vector<Value> values;
+          for (uint32_t i = 0; i < column_cnt_; i++) {
+            values.push_back(plan_->OutputSchema()->GetColumn(i).GetExpr()->Evaluate(
+                left_or_right_[i] == 0 ? &left_tuple : &right_tuple_,
+                left_or_right_[i] == 0 ? plan_->GetLeftPlan()->OutputSchema() : plan_->GetRightPlan()->OutputSchema()));
+          }
+          *tuple = Tuple(values, plan_->OutputSchema());
+          return true;
         }
-        *tuple = Tuple(values, plan_->OutputSchema());
-        return true;
       }
+      has_right_ = false;
+    }
+
+    /* join the next right tuple with the block, or move on to the next block once the right side is exhausted */
+    if (!left_block_.empty() && right_executor_->Next(&right_tuple_, rid)) {
+      has_right_ = true;
+      left_idx_ = 0;
+    } else if (!NextLeftBlock()) {
+      return false;
     }
   }
 }
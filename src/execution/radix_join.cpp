@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// radix_join.cpp
+//
+// Identification: src/execution/radix_join.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "execution/radix_join.h"
+
+namespace bustub {
+
+void RadixJoin::Partition(std::vector<Entry> left, std::vector<Entry> right) {
+  left_ = std::move(left);
+  right_ = std::move(right);
+
+  /* enough radix bits for the build partitions to fit in cache, split as evenly as can be over the passes */
+  radix_bits_ = 0;
+  while ((left_.size() >> radix_bits_) > partition_entries_) {
+    radix_bits_++;
+  }
+  uint32_t num_passes = (radix_bits_ + BITS_PER_PASS - 1) / BITS_PER_PASS;
+
+  left_bounds_ = {0, left_.size()};
+  right_bounds_ = {0, right_.size()};
+  uint32_t shift = 0;
+  for (uint32_t pass = 0; pass < num_passes; pass++) {
+    uint32_t bits = (radix_bits_ - shift) / (num_passes - pass);
+    if (pass == 0) {
+      left_bounds_ = PartitionFirstPass(&left_, bits);
+      right_bounds_ = PartitionFirstPass(&right_, bits);
+    } else {
+      PartitionNextPass(&left_, &left_bounds_, shift, bits);
+      PartitionNextPass(&right_, &right_bounds_, shift, bits);
+    }
+    shift += bits;
+  }
+}
+
+void RadixJoin::JoinPartitions(std::size_t first, std::size_t count, const KeyEqual &equal,
+                               std::vector<Matches> *matches) const {
+  matches->assign(count, {});
+  RunTasks(count, [&](std::size_t i) {
+    std::size_t p = first + i;
+    JoinPartition(left_.data() + left_bounds_[p], left_bounds_[p + 1] - left_bounds_[p],
+                  right_.data() + right_bounds_[p], right_bounds_[p + 1] - right_bounds_[p], radix_bits_, equal,
+                  &(*matches)[i]);
+  });
+}
+
+std::vector<RadixJoin::Matches> RadixJoin::Join(std::vector<Entry> left, std::vector<Entry> right,
+                                                const KeyEqual &equal) {
+  Partition(std::move(left), std::move(right));
+  std::vector<Matches> matches;
+  JoinPartitions(0, GetPartitionCount(), equal, &matches);
+  return matches;
+}
+
+void RadixJoin::RunTasks(std::size_t num_tasks, const std::function<void(std::size_t)> &task) const {
+  std::size_t num_workers = std::min(parallelism_, num_tasks);
+  if (num_workers <= 1) {
+    for (std::size_t i = 0; i < num_tasks; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_task{0};
+  std::vector<std::exception_ptr> errors(num_workers);
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < num_workers; i++) {
+    workers.emplace_back([&, i] {
+      try {
+        for (std::size_t t = next_task++; t < num_tasks; t = next_task++) {
+          task(t);
+        }
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+std::vector<std::size_t> RadixJoin::PartitionFirstPass(std::vector<Entry> *entries, uint32_t bits) const {
+  const std::size_t fanout = static_cast<std::size_t>(1) << bits;
+  const hash_t mask = fanout - 1;
+  const std::size_t num_chunks = std::max<std::size_t>(parallelism_, 1);
+  const std::size_t chunk_size = (entries->size() + num_chunks - 1) / num_chunks;
+  auto chunk_begin = [&](std::size_t chunk) { return std::min(chunk * chunk_size, entries->size()); };
+
+  std::vector<std::vector<std::size_t>> histograms(num_chunks, std::vector<std::size_t>(fanout));
+  RunTasks(num_chunks, [&](std::size_t chunk) {
+    for (std::size_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+      histograms[chunk][(*entries)[i].hash_ & mask]++;
+    }
+  });
+
+  /* turn the histograms into the offsets each chunk writes its entries of a partition from */
+  std::vector<std::size_t> bounds(fanout + 1);
+  std::size_t offset = 0;
+  for (std::size_t p = 0; p < fanout; p++) {
+    bounds[p] = offset;
+    for (auto &histogram : histograms) {
+      std::size_t count = histogram[p];
+      histogram[p] = offset;
+      offset += count;
+    }
+  }
+  bounds[fanout] = offset;
+
+  std::vector<Entry> out(entries->size());
+  RunTasks(num_chunks, [&](std::size_t chunk) {
+    auto &next = histograms[chunk];
+    for (std::size_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) {
+      const Entry &entry = (*entries)[i];
+      out[next[entry.hash_ & mask]++] = entry;
+    }
+  });
+  *entries = std::move(out);
+  return bounds;
+}
+
+void RadixJoin::PartitionNextPass(std::vector<Entry> *entries, std::vector<std::size_t> *bounds, uint32_t shift,
+                                  uint32_t bits) const {
+  const std::size_t fanout = static_cast<std::size_t>(1) << bits;
+  const hash_t mask = fanout - 1;
+  const std::size_t num_partitions = bounds->size() - 1;
+
+  std::vector<Entry> out(entries->size());
+  std::vector<std::size_t> new_bounds(num_partitions * fanout + 1);
+  new_bounds.back() = entries->size();
+  RunTasks(num_partitions, [&](std::size_t p) {
+    std::vector<std::size_t> next(fanout);
+    for (std::size_t i = (*bounds)[p]; i < (*bounds)[p + 1]; i++) {
+      next[((*entries)[i].hash_ >> shift) & mask]++;
+    }
+    std::size_t offset = (*bounds)[p];
+    for (std::size_t q = 0; q < fanout; q++) {
+      new_bounds[p * fanout + q] = offset;
+      std::size_t count = next[q];
+      next[q] = offset;
+      offset += count;
+    }
+    for (std::size_t i = (*bounds)[p]; i < (*bounds)[p + 1]; i++) {
+      const Entry &entry = (*entries)[i];
+      out[next[(entry.hash_ >> shift) & mask]++] = entry;
+    }
+  });
+  *entries = std::move(out);
+  *bounds = std::move(new_bounds);
+}
+
+void RadixJoin::JoinPartition(const Entry *left, std::size_t left_size, const Entry *right, std::size_t right_size,
+                              uint32_t radix_bits, const KeyEqual &equal, Matches *matches) const {
+  if (left_size == 0 || right_size == 0) {
+    return;
+  }
+
+  /* linear probing over the positions of the left entries, at most half full; the radix bits are the same for */
+  /* every entry of the partition, so the slot comes from the bits above them */
+  constexpr uint32_t empty = std::numeric_limits<uint32_t>::max();
+  std::size_t capacity = 1;
+  while (capacity < 2 * left_size) {
+    capacity <<= 1;
+  }
+  const std::size_t slot_mask = capacity - 1;
+  std::vector<uint32_t> slots(capacity, empty);
+  for (std::size_t i = 0; i < left_size; i++) {
+    std::size_t slot = (left[i].hash_ >> radix_bits) & slot_mask;
+    while (slots[slot] != empty) {
+      slot = (slot + 1) & slot_mask;
+    }
+    slots[slot] = static_cast<uint32_t>(i);
+  }
+
+  for (std::size_t i = 0; i < right_size; i++) {
+    const Entry &probe = right[i];
+    for (std::size_t slot = (probe.hash_ >> radix_bits) & slot_mask; slots[slot] != empty;
+         slot = (slot + 1) & slot_mask) {
+      const Entry &build = left[slots[slot]];
+      if (build.hash_ == probe.hash_ && equal(build.idx_, probe.idx_)) {
+        matches->emplace_back(build.idx_, probe.idx_);
+      }
+    }
+  }
+}
+
+}  // namespace bustub
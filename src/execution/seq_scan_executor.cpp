@@ -10,8 +10,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <utility>
+#include <vector>
+
 #include "execution/executors/seq_scan_executor.h"
+#include "common/config.h"
+#include "common/exception.h"
 #include "concurrency/transaction.h"
+#include "execution/constant_comparison_filter.h"
+#include "execution/expressions/column_value_expression.h"
 
 namespace bustub {
 
@@ -21,32 +28,45 @@ SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNod
       cur_(nullptr, RID(INVALID_PAGE_ID, 0), nullptr),
       end_(nullptr, RID(INVALID_PAGE_ID, 0), nullptr) {}
 
+SeqScanExecutor::~SeqScanExecutor() { StopWorkers(); }
+
 void SeqScanExecutor::Init() {
   table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
 
-  cur_ = table_info_->table_->Begin(exec_ctx_->GetTransaction());
+  /* comparisons against constants are checked on the tuple bytes in the page, so that only the tuples passing */
+  /* them are copied and locked */
+  filter_ = MakeConstantComparisonFilter(plan_->GetPredicate(), &table_info_->schema_);
+  if (bloom_filter_ != nullptr) {
+    filter_ = std::make_unique<BloomTupleFilter>(bloom_filter_, table_info_->schema_.GetColumn(bloom_column_),
+                                                 std::move(filter_));
+  }
+  cur_ = table_info_->table_->Begin(exec_ctx_->GetTransaction(), filter_.get());
   end_ = table_info_->table_->End();
+
+  /* with logging on, reading a tuple locks it behind our back, so stay serial as Catalog::CreateIndex does; */
+  /* the scan also stays serial if the page chain cannot be read up front */
+  StopWorkers();
+  dispenser_.reset();
+  std::vector<page_id_t> page_ids;
+  if (exec_ctx_->GetParallelism() > 1 && !enable_logging && table_info_->table_->GetPageIds(&page_ids)) {
+    dispenser_ = std::make_unique<MorselDispenser>(std::move(page_ids));
+  }
+  queue_.clear();
+  running_workers_ = 0;
+  stop_ = false;
+  error_ = nullptr;
 }
 
 bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) {
-  Transaction *txn = exec_ctx_->GetTransaction();
-
   while (cur_ != end_) {
     *rid = cur_->GetRid();
 
-    if ((!txn->IsExclusiveLocked(*rid) && !txn->IsSharedLocked(*rid)) &&
-        txn->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED) {
-      exec_ctx_->GetLockManager()->LockShared(txn, *rid);
-    }
-
+    LockRow(*rid);
     *tuple = *cur_++;
-
-    if (txn->GetIsolationLevel() == IsolationLevel::READ_COMMITTED && txn->IsSharedLocked(*rid)) {
-      exec_ctx_->GetLockManager()->Unlock(txn, *rid);
-    }
+    UnlockRow(*rid);
 
     if ((plan_->GetPredicate() == nullptr) ||
-        plan_->GetPredicate()->Evaluate(tuple, plan_->OutputSchema()).GetAs<bool>()) {
+        plan_->GetPredicate()->Evaluate(tuple, &table_info_->schema_).GetAs<bool>()) {
       /* we must return tuple with output schema instead of table schema */
       std::vector<Value> values;
       for (auto &output_column : plan_->OutputSchema()->GetColumns()) {
@@ -62,4 +82,168 @@ bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) {
   return false;
 }
 
+bool SeqScanExecutor::NextBatch(TupleBatch *batch) {
+  if (dispenser_ != nullptr) {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (workers_.empty()) {
+      running_workers_ = exec_ctx_->GetParallelism();
+      for (std::size_t i = 0; i < running_workers_; i++) {
+        workers_.emplace_back(&SeqScanExecutor::Work, this);
+      }
+    }
+    queue_cv_.wait(lock, [&] { return !queue_.empty() || running_workers_ == 0 || error_ != nullptr; });
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    if (queue_.empty()) {
+      return false;
+    }
+    *batch = std::move(queue_.front());
+    queue_.pop_front();
+    queue_cv_.notify_all();
+    return true;
+  }
+
+  while (cur_ != end_) {
+    scan_batch_.Reset(&table_info_->schema_);
+    while (cur_ != end_ && !scan_batch_.IsFull()) {
+      RID rid = cur_->GetRid();
+      LockRow(rid);
+      scan_batch_.AppendTuple(*cur_, rid);
+      ++cur_;
+      UnlockRow(rid);
+    }
+    if (FilterAndProject(&scan_batch_, batch)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool SeqScanExecutor::PushDownBloomFilter(uint32_t col_idx, std::shared_ptr<const BloomFilter> filter) {
+  const auto *column =
+      dynamic_cast<const ColumnValueExpression *>(plan_->OutputSchema()->GetColumn(col_idx).GetExpr());
+  if (column == nullptr) {
+    return false;
+  }
+  bloom_filter_ = std::move(filter);
+  bloom_column_ = column->GetColIdx();
+  return true;
+}
+
+bool SeqScanExecutor::NextMorsel(TupleBatch *batch) {
+  std::vector<page_id_t> morsel;
+  if (!dispenser_->Next(&morsel)) {
+    return false;
+  }
+
+  std::vector<Tuple> tuples;
+  for (page_id_t page_id : morsel) {
+    if (!table_info_->table_->GetPageTuples(page_id, &tuples, exec_ctx_->GetTransaction(), filter_.get())) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot read table page");
+    }
+  }
+  TupleBatch rows;
+  rows.Reset(&table_info_->schema_);
+  for (const auto &tuple : tuples) {
+    LockRow(tuple.GetRid());
+    rows.AppendTuple(tuple, tuple.GetRid());
+    UnlockRow(tuple.GetRid());
+  }
+  if (!FilterAndProject(&rows, batch)) {
+    batch->Reset(plan_->OutputSchema());
+  }
+  return true;
+}
+
+void SeqScanExecutor::LockRow(const RID &rid) {
+  Transaction *txn = exec_ctx_->GetTransaction();
+  std::lock_guard<std::mutex> guard(lock_mutex_);
+  if ((!txn->IsExclusiveLocked(rid) && !txn->IsSharedLocked(rid)) &&
+      txn->GetIsolationLevel() != IsolationLevel::READ_UNCOMMITTED) {
+    exec_ctx_->GetLockManager()->LockShared(txn, rid);
+  }
+}
+
+void SeqScanExecutor::UnlockRow(const RID &rid) {
+  Transaction *txn = exec_ctx_->GetTransaction();
+  std::lock_guard<std::mutex> guard(lock_mutex_);
+  if (txn->GetIsolationLevel() == IsolationLevel::READ_COMMITTED && txn->IsSharedLocked(rid)) {
+    exec_ctx_->GetLockManager()->Unlock(txn, rid);
+  }
+}
+
+bool SeqScanExecutor::FilterAndProject(TupleBatch *rows, TupleBatch *batch) const {
+  if (plan_->GetPredicate() != nullptr) {
+    std::vector<Value> matches;
+    plan_->GetPredicate()->EvaluateBatch(*rows, &matches);
+    std::vector<uint32_t> selection;
+    for (uint32_t i = 0; i < matches.size(); i++) {
+      if (matches[i].GetAs<bool>()) {
+        selection.push_back(rows->GetSelection()[i]);
+      }
+    }
+    rows->Select(std::move(selection));
+  }
+  if (rows->IsEmpty()) {
+    return false;
+  }
+
+  /* project the surviving rows onto the output schema, one column at a time */
+  std::vector<std::vector<Value>> columns(plan_->OutputSchema()->GetColumnCount());
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    plan_->OutputSchema()->GetColumn(i).GetExpr()->EvaluateBatch(*rows, &columns[i]);
+  }
+  std::vector<RID> rids;
+  rids.reserve(rows->Size());
+  for (uint32_t row : rows->GetSelection()) {
+    rids.push_back(rows->GetRid(row));
+  }
+  batch->Reset(plan_->OutputSchema());
+  batch->SetColumns(std::move(columns), std::move(rids));
+  return true;
+}
+
+void SeqScanExecutor::Work() {
+  /* at most two batches per worker wait in the queue, so a slow consumer holds the workers back */
+  const std::size_t max_queued = 2 * exec_ctx_->GetParallelism();
+  TupleBatch batch;
+  try {
+    while (!stop_ && NextMorsel(&batch)) {
+      if (batch.IsEmpty()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [&] { return queue_.size() < max_queued || stop_; });
+      if (stop_) {
+        break;
+      }
+      queue_.push_back(std::move(batch));
+      queue_cv_.notify_all();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> guard(queue_mutex_);
+    if (error_ == nullptr) {
+      error_ = std::current_exception();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(queue_mutex_);
+  running_workers_--;
+  queue_cv_.notify_all();
+}
+
+void SeqScanExecutor::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> guard(queue_mutex_);
+    stop_ = true;
+    queue_cv_.notify_all();
+  }
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
 }  // namespace bustub
@@ -0,0 +1,167 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.cpp
+//
+// Identification: src/execution/sort_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "execution/executors/sort_executor.h"
+
+namespace bustub {
+
+SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBys()) {}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  tuples_.clear();
+  keys_.clear();
+  memory_used_ = 0;
+  order_.clear();
+  next_ = 0;
+  merge_.reset();
+  runs_.clear();
+  advance_ = false;
+
+  const auto &order_bys = plan_->GetOrderBys();
+  std::size_t budget = GetExecutorContext()->GetMemoryBudget();
+  TupleBatch batch;
+  std::vector<std::vector<Value>> columns(order_bys.size());
+  std::vector<Value> values(order_bys.size());
+  while (child_executor_->NextBatch(&batch)) {
+    for (std::size_t i = 0; i < order_bys.size(); i++) {
+      order_bys[i].second->EvaluateBatch(batch, &columns[i]);
+    }
+    const auto &selection = batch.GetSelection();
+    for (std::size_t row = 0; row < selection.size(); row++) {
+      for (std::size_t i = 0; i < order_bys.size(); i++) {
+        values[i] = columns[i][row];
+      }
+      keys_.push_back(encoder_.Encode(values));
+      tuples_.push_back(batch.GetTuple(selection[row]));
+      memory_used_ += sizeof(Tuple) + tuples_.back().GetLength() + sizeof(std::string) + keys_.back().size();
+      if (budget != 0 && memory_used_ > budget) {
+        SpillRun();
+      }
+    }
+  }
+
+  if (runs_.empty()) {
+    SortInMemory();
+    return;
+  }
+  if (!tuples_.empty()) {
+    SpillRun();
+  }
+  for (auto &run : runs_) {
+    ReadRunPage(&run);
+  }
+  merge_ = std::make_unique<LoserTree>(runs_.size(), [this](std::size_t a, std::size_t b) {
+    const Run &run_a = runs_[a];
+    const Run &run_b = runs_[b];
+    if (run_a.head_ == run_a.tuples_.size()) {
+      return false;
+    }
+    return run_b.head_ == run_b.tuples_.size() || run_a.keys_[run_a.head_] < run_b.keys_[run_b.head_];
+  });
+}
+
+std::string SortExecutor::EncodeKey(const Tuple &tuple) const {
+  const Schema *schema = child_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  for (const auto &order_by : plan_->GetOrderBys()) {
+    values.push_back(order_by.second->Evaluate(&tuple, schema));
+  }
+  return encoder_.Encode(values);
+}
+
+void SortExecutor::SortInMemory() {
+  order_.resize(tuples_.size());
+  for (std::size_t i = 0; i < order_.size(); i++) {
+    order_[i] = static_cast<uint32_t>(i);
+  }
+  // sort indexes rather than the tuples, which have no cheap move
+  std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) { return keys_[a] < keys_[b]; });
+}
+
+void SortExecutor::SpillRun() {
+  SortInMemory();
+  Run run;
+  run.file_ = std::make_unique<TmpTupleFile>(GetExecutorContext()->GetBufferPoolManager());
+  for (uint32_t idx : order_) {
+    run.file_->Append(tuples_[idx]);
+  }
+  runs_.push_back(std::move(run));
+  tuples_.clear();
+  keys_.clear();
+  order_.clear();
+  memory_used_ = 0;
+}
+
+bool SortExecutor::ReadRunPage(Run *run) {
+  run->tuples_.clear();
+  run->keys_.clear();
+  run->head_ = 0;
+  if (run->next_page_ == run->file_->GetPageCount()) {
+    return false;
+  }
+  run->file_->ReadPage(run->next_page_++, &run->tuples_);
+  std::reverse(run->tuples_.begin(), run->tuples_.end());
+  for (const auto &tuple : run->tuples_) {
+    run->keys_.push_back(EncodeKey(tuple));
+  }
+  return true;
+}
+
+const Tuple *SortExecutor::NextSortedTuple() {
+  if (merge_ == nullptr) {
+    return next_ < order_.size() ? &tuples_[order_[next_++]] : nullptr;
+  }
+
+  if (advance_) {
+    Run &run = runs_[merge_->GetWinner()];
+    if (++run.head_ == run.tuples_.size()) {
+      ReadRunPage(&run);
+    }
+    merge_->Replay();
+    advance_ = false;
+  }
+  Run &run = runs_[merge_->GetWinner()];
+  if (run.head_ == run.tuples_.size()) {
+    return nullptr;
+  }
+  advance_ = true;
+  return &run.tuples_[run.head_];
+}
+
+bool SortExecutor::Next(Tuple *tuple, RID *rid) {
+  const Tuple *next = NextSortedTuple();
+  if (next == nullptr) {
+    return false;
+  }
+  *tuple = *next;
+  *rid = next->GetRid();
+  return true;
+}
+
+bool SortExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset(GetOutputSchema());
+  const Tuple *next;
+  while (!batch->IsFull() && (next = NextSortedTuple()) != nullptr) {
+    batch->AppendTuple(*next, next->GetRid());
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
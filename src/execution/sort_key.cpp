@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+#include "storage/index/key_encoder.h"
+
+namespace bustub {
+
+namespace {
+
+std::vector<Column> MakeKeyColumns(const std::vector<std::pair<OrderByType, const AbstractExpression *>> &order_bys) {
+  std::vector<Column> columns;
+  for (std::size_t i = 0; i < order_bys.size(); i++) {
+    TypeId type = order_bys[i].second->GetReturnType();
+    std::string name = "order_by_" + std::to_string(i);
+    if (type == TypeId::VARCHAR) {
+      // the tuples never limit the length of a varchar
+      columns.emplace_back(name, type, 0);
+    } else {
+      columns.emplace_back(name, type);
+    }
+  }
+  return columns;
+}
+
+}  // namespace
+
+SortKeyEncoder::SortKeyEncoder(const std::vector<std::pair<OrderByType, const AbstractExpression *>> &order_bys)
+    : key_schema_(MakeKeyColumns(order_bys)) {
+  for (const auto &order_by : order_bys) {
+    descending_.push_back(order_by.first == OrderByType::Desc);
+  }
+}
+
+std::string SortKeyEncoder::Encode(const std::vector<Value> &values) const {
+  Tuple tuple(values, &key_schema_);
+  // a first pass without a buffer measures the key
+  KeyEncoder measure(nullptr, 0);
+  measure.PutTuple(tuple, &key_schema_);
+
+  std::string key(measure.GetLength(), '\0');
+  KeyEncoder encoder(key.data(), key.size());
+  for (uint32_t i = 0; i < key_schema_.GetColumnCount(); i++) {
+    std::size_t start = encoder.GetLength();
+    encoder.PutColumn(tuple, key_schema_.GetColumn(i));
+    if (descending_[i]) {
+      encoder.InvertFrom(start);
+    }
+  }
+  return key;
+}
+
+}  // namespace bustub
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_executor.cpp
+//
+// Identification: src/execution/top_n_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "execution/executors/top_n_executor.h"
+
+namespace bustub {
+
+TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBys()) {}
+
+TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *limit_plan, const SortPlanNode *sort_plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx),
+      fused_plan_(std::make_unique<TopNPlanNode>(limit_plan->OutputSchema(), sort_plan->GetChildPlan(),
+                                                 sort_plan->GetOrderBys(), limit_plan->GetLimit())),
+      plan_(fused_plan_.get()),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan_->GetOrderBys()) {}
+
+void TopNExecutor::Init() {
+  child_executor_->Init();
+  tuples_.clear();
+  keys_.clear();
+  heap_.clear();
+  next_ = 0;
+
+  std::size_t n = plan_->GetN();
+  if (n == 0) {
+    return;
+  }
+  auto key_less = [this](uint32_t a, uint32_t b) { return keys_[a] < keys_[b]; };
+  const auto &order_bys = plan_->GetOrderBys();
+  TupleBatch batch;
+  std::vector<std::vector<Value>> columns(order_bys.size());
+  std::vector<Value> values(order_bys.size());
+  while (child_executor_->NextBatch(&batch)) {
+    for (std::size_t i = 0; i < order_bys.size(); i++) {
+      order_bys[i].second->EvaluateBatch(batch, &columns[i]);
+    }
+    const auto &selection = batch.GetSelection();
+    for (std::size_t row = 0; row < selection.size(); row++) {
+      for (std::size_t i = 0; i < order_bys.size(); i++) {
+        values[i] = columns[i][row];
+      }
+      std::string key = encoder_.Encode(values);
+      if (heap_.size() < n) {
+        heap_.push_back(static_cast<uint32_t>(tuples_.size()));
+        keys_.push_back(std::move(key));
+        tuples_.push_back(batch.GetTuple(selection[row]));
+        std::push_heap(heap_.begin(), heap_.end(), key_less);
+        continue;
+      }
+      // only a tuple that sorts before the largest one kept replaces it, so ties keep the earliest tuples
+      if (key < keys_[heap_.front()]) {
+        std::pop_heap(heap_.begin(), heap_.end(), key_less);
+        uint32_t slot = heap_.back();
+        keys_[slot] = std::move(key);
+        tuples_[slot] = batch.GetTuple(selection[row]);
+        std::push_heap(heap_.begin(), heap_.end(), key_less);
+      }
+    }
+  }
+  std::sort_heap(heap_.begin(), heap_.end(), key_less);
+}
+
+bool TopNExecutor::Next(Tuple *tuple, RID *rid) {
+  if (next_ == heap_.size()) {
+    return false;
+  }
+  *tuple = tuples_[heap_[next_++]];
+  *rid = tuple->GetRid();
+  return true;
+}
+
+bool TopNExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset(GetOutputSchema());
+  while (!batch->IsFull() && next_ < heap_.size()) {
+    const Tuple &tuple = tuples_[heap_[next_++]];
+    batch->AppendTuple(tuple, tuple.GetRid());
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.cpp
+//
+// Identification: src/execution/tuple_batch.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <utility>
+
+#include "execution/tuple_batch.h"
+
+namespace bustub {
+
+void TupleBatch::Reset(const Schema *schema) {
+  schema_ = schema;
+  columns_.resize(schema == nullptr ? 0 : schema->GetColumnCount());
+  for (auto &column : columns_) {
+    column.clear();
+  }
+  rids_.clear();
+  selection_.clear();
+}
+
+void TupleBatch::Truncate(uint32_t size) {
+  if (size < selection_.size()) {
+    selection_.resize(size);
+  }
+}
+
+void TupleBatch::AppendTuple(const Tuple &tuple, const RID &rid) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].push_back(tuple.GetValue(schema_, i));
+  }
+  selection_.push_back(GetRowCount());
+  rids_.push_back(rid);
+}
+
+void TupleBatch::AppendRow(const std::vector<Value> &values, const RID &rid) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].push_back(values[i]);
+  }
+  selection_.push_back(GetRowCount());
+  rids_.push_back(rid);
+}
+
+void TupleBatch::SetColumns(std::vector<std::vector<Value>> &&columns, std::vector<RID> &&rids) {
+  columns_ = std::move(columns);
+  rids_ = std::move(rids);
+  selection_.resize(rids_.size());
+  for (uint32_t i = 0; i < selection_.size(); i++) {
+    selection_[i] = i;
+  }
+}
+
+Tuple TupleBatch::GetTuple(uint32_t row) const {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (const auto &column : columns_) {
+    values.push_back(column[row]);
+  }
+  return Tuple(values, schema_);
+}
+
+}  // namespace bustub
@@ -12,17 +12,28 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "common/config.h"
 #include "container/hash/hash_function.h"
+#include "storage/index/b_epsilon_tree_index.h"
+#include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
 #include "storage/index/index.h"
+#include "storage/index/linear_probe_hash_table_index.h"
+#include "storage/index/varlen_b_plus_tree_index.h"
+#include "storage/page/header_page.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -34,6 +45,22 @@ using table_oid_t = uint32_t;
 using column_oid_t = uint32_t;
 using index_oid_t = uint32_t;
 
+/**
+ * The kinds of index that Catalog::CreateIndex can build.
+ * BLinkBPlusTree is a BPlusTree under the B_LINK protocol, whose lookups never latch (see BPlusTreeProtocol).
+ * NonUniqueBPlusTree and BEpsilonTree allow duplicate keys, but their KeyType has to leave room for a RID (see
+ * GenericKey).
+ */
+enum class IndexType {
+  ExtendibleHashTable,
+  LinearProbeHashTable,
+  BPlusTree,
+  BLinkBPlusTree,
+  NonUniqueBPlusTree,
+  VarlenBPlusTree,
+  BEpsilonTree
+};
+
 /**
  * The TableInfo class maintains metadata about a table.
  */
@@ -186,12 +213,16 @@ class Catalog {
    * @param key_attrs Key attributes
    * @param keysize Size of the key
    * @param hash_function The hash function for the index
-   * @return A (non-owning) pointer to the metadata of the new table
+   * @param index_type The kind of index to build
+   * @param build_threads The number of threads that populate the index, 0 for one per hardware thread
+   * @return A (non-owning) pointer to the metadata of the new table, or NULL_INDEX_INFO if the table does not
+   * exist, the index already exists, or the tuples of the table could not all be read
    */
   template <class KeyType, class ValueType, class KeyComparator>
   IndexInfo *CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name,
                          const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs,
-                         std::size_t keysize, HashFunction<KeyType> hash_function) {
+                         std::size_t keysize, HashFunction<KeyType> hash_function,
+                         IndexType index_type = IndexType::ExtendibleHashTable, std::size_t build_threads = 0) {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -210,19 +241,70 @@ class Catalog {
     // Construct index metdata
     auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
 
+    // Collect the keys of all tuples in table heap, in parallel; an index missing some of them is no index at all
+    auto *table_meta = GetTable(table_name);
+    std::vector<std::vector<std::pair<Tuple, RID>>> partitions;
+    if (!ExtractIndexEntries(table_meta->table_.get(), schema, key_schema, key_attrs, build_threads, txn,
+                             &partitions)) {
+      txn->SetState(TransactionState::ABORTED);
+      return NULL_INDEX_INFO;
+    }
+    std::size_t num_entries = 0;
+    for (const auto &partition : partitions) {
+      num_entries += partition.size();
+    }
+
     // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
-    auto index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
-                                                                                               hash_function);
+    std::unique_ptr<Index> index;
+    switch (index_type) {
+      case IndexType::LinearProbeHashTable: {
+        // Leave enough room for the existing tuples (and at least one block page) so that populating
+        // the index does not trigger a resize, up to the most buckets a header page can address
+        size_t max_buckets = HashTableHeaderPage::MaxNumBlocks() * BLOCK_ARRAY_SIZE;
+        size_t num_buckets = std::min(std::max<size_t>(num_entries * 2, BLOCK_ARRAY_SIZE), max_buckets);
+        index = std::make_unique<LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>>(
+            std::move(meta), bpm_, num_buckets, hash_function);
+        break;
+      }
+      case IndexType::BPlusTree:
+      case IndexType::BLinkBPlusTree:
+      case IndexType::NonUniqueBPlusTree:
+      case IndexType::VarlenBPlusTree:
+      case IndexType::BEpsilonTree: {
+        // Page 0 is not reserved for a header page here, so the tree records its root in a header page of its own
+        page_id_t header_page_id;
+        auto *header_page = static_cast<HeaderPage *>(bpm_->NewPage(&header_page_id));
+        BUSTUB_ASSERT(header_page != nullptr, "Couldn't create a header page for the index.");
+        header_page->Init();
+        bpm_->UnpinPage(header_page_id, true);
+        if (index_type == IndexType::VarlenBPlusTree) {
+          index = std::make_unique<VarlenBPlusTreeIndex>(std::move(meta), bpm_, header_page_id);
+        } else if (index_type == IndexType::BEpsilonTree) {
+          index = std::make_unique<BEpsilonTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                         header_page_id);
+        } else {
+          auto protocol =
+              index_type == IndexType::BLinkBPlusTree ? BPlusTreeProtocol::B_LINK : BPlusTreeProtocol::LATCH_CRABBING;
+          index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(
+              std::move(meta), bpm_, protocol, header_page_id, index_type != IndexType::NonUniqueBPlusTree);
+        }
+        break;
+      }
+      case IndexType::ExtendibleHashTable:
+      default:
+        index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                              hash_function);
+        break;
+    }
 
-    // Populate the index with all tuples in table heap
-    auto *table_meta = GetTable(table_name);
-    auto *heap = table_meta->table_.get();
-    for (auto tuple = heap->Begin(txn); tuple != heap->End(); ++tuple) {
-      index->InsertEntry(tuple->KeyFromTuple(schema, key_schema, key_attrs), tuple->GetRid(), txn);
+    // Populate the index with all tuples in table heap, in one batch so that the index can build itself in bulk
+    std::vector<std::pair<Tuple, RID>> entries;
+    entries.reserve(num_entries);
+    for (auto &partition : partitions) {
+      std::move(partition.begin(), partition.end(), std::back_inserter(entries));
+      partition.clear();
     }
+    index->BulkInsertEntries(entries, txn);
 
     // Get the next OID for the new index
     const auto index_oid = next_index_oid_.fetch_add(1);
@@ -323,6 +405,62 @@ class Catalog {
   }
 
  private:
+  /**
+   * Read the index entries of all tuples in a table heap. The pages of the heap are split into contiguous runs,
+   * one per worker, so the partitions hold the entries in table order.
+   * @param num_threads The number of workers, 0 for one per hardware thread
+   * @param[out] partitions One partition of (index key, RID) pairs per worker
+   * @return `false` if a page or a tuple of the heap could not be read; txn is left for the caller to abort
+   */
+  bool ExtractIndexEntries(TableHeap *heap, const Schema &schema, const Schema &key_schema,
+                           const std::vector<uint32_t> &key_attrs, std::size_t num_threads, Transaction *txn,
+                           std::vector<std::vector<std::pair<Tuple, RID>>> *partitions) {
+    std::vector<page_id_t> page_ids;
+    if (!heap->GetPageIds(&page_ids)) {
+      return false;
+    }
+    if (num_threads == 0) {
+      num_threads = std::thread::hardware_concurrency();
+    }
+    if (enable_logging) {
+      // reads take tuple locks on behalf of txn, which is not thread safe
+      num_threads = 1;
+    }
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, page_ids.size()));
+
+    partitions->assign(num_threads, {});
+    std::atomic<bool> failed{false};
+    RunInParallel(num_threads, [&](std::size_t i) {
+      std::vector<Tuple> tuples;
+      for (auto page = page_ids.size() * i / num_threads; page < page_ids.size() * (i + 1) / num_threads; page++) {
+        tuples.clear();
+        // stop early once any worker has failed, since the index will not be built
+        if (failed || !heap->GetPageTuples(page_ids[page], &tuples, txn)) {
+          failed = true;
+          return;
+        }
+        for (auto &tuple : tuples) {
+          (*partitions)[i].emplace_back(tuple.KeyFromTuple(schema, key_schema, key_attrs), tuple.GetRid());
+        }
+      }
+    });
+    return !failed;
+  }
+
+  /** Run work(0), ..., work(num_workers - 1) on threads of their own, the first one on the calling thread. */
+  static void RunInParallel(std::size_t num_workers, const std::function<void(std::size_t)> &work) {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < num_workers; i++) {
+      threads.emplace_back(work, i);
+    }
+    if (num_workers > 0) {
+      work(0);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] LockManager *lock_manager_;
   [[maybe_unused]] LogManager *log_manager_;
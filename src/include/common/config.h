@@ -35,6 +35,10 @@ static constexpr int PAGE_SIZE = 4096;                                        //
 static constexpr int BUFFER_POOL_SIZE = 10;                                   // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
+static constexpr int TUPLE_BATCH_SIZE = 1024;                                 // max rows in a TupleBatch
+static constexpr int MORSEL_SIZE = 8;                                         // table pages per parallel scan morsel
+static constexpr int SPILL_PARTITIONS = 16;                                   // partitions of a spilling hash join
+static constexpr int NLJ_BLOCK_PAGES = 16;                                    // outer pages buffered per nested loop join block
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -13,7 +13,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -28,33 +30,103 @@ class HashUtil {
  private:
   static const hash_t PRIME_FACTOR = 10000019;
 
+  /** Secrets of the multiply-mix hash, taken from wyhash */
+  static constexpr uint64_t SECRET0 = 0x2d358dccaa6c78a5ULL;
+  static constexpr uint64_t SECRET1 = 0x8bb84b93962eacc9ULL;
+
+  /** Replaces a and b with the low and high halves of their 128-bit product */
+  static inline void Mum(uint64_t *a, uint64_t *b) {
+    __uint128_t r = static_cast<__uint128_t>(*a) * *b;
+    *a = static_cast<uint64_t>(r);
+    *b = static_cast<uint64_t>(r >> 64);
+  }
+
+  /** @return the xor of the low and high halves of the 128-bit product of a and b */
+  static inline uint64_t Mix(uint64_t a, uint64_t b) {
+    Mum(&a, &b);
+    return a ^ b;
+  }
+
+  static inline uint64_t Read8(const char *bytes) {
+    uint64_t v;
+    memcpy(&v, bytes, sizeof(v));
+    return v;
+  }
+
+  static inline uint64_t Read4(const char *bytes) {
+    uint32_t v;
+    memcpy(&v, bytes, sizeof(v));
+    return v;
+  }
+
  public:
   static inline hash_t HashBytes(const char *bytes, size_t length) {
-    // https://github.com/greenplum-db/gpos/blob/b53c1acd6285de94044ff91fbee91589543feba1/libgpos/src/utils.cpp#L126
-    hash_t hash = length;
-    for (size_t i = 0; i < length; ++i) {
-      hash = ((hash << 5) ^ (hash >> 27)) ^ bytes[i];
+    // Word-at-a-time multiply-mix hash following the design of wyhash (https://github.com/wangyi-fudan/wyhash):
+    // 16 bytes are consumed per 64x64->128 bit multiplication instead of one byte per shift/xor round.
+    uint64_t seed = SECRET0;
+    uint64_t a;
+    uint64_t b;
+    if (length <= 16) {
+      if (length >= 4) {
+        // two possibly overlapping 4-byte reads from each end cover every length in [4, 16]
+        size_t mid = (length >> 3) << 2;
+        a = (Read4(bytes) << 32) | Read4(bytes + mid);
+        b = (Read4(bytes + length - 4) << 32) | Read4(bytes + length - 4 - mid);
+      } else if (length > 0) {
+        auto *p = reinterpret_cast<const uint8_t *>(bytes);
+        a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+        b = 0;
+      } else {
+        a = b = 0;
+      }
+    } else {
+      size_t i = length;
+      while (i > 16) {
+        seed = Mix(Read8(bytes) ^ SECRET1, Read8(bytes + 8) ^ seed);
+        bytes += 16;
+        i -= 16;
+      }
+      a = Read8(bytes + i - 16);
+      b = Read8(bytes + i - 8);
     }
-    return hash;
+    a ^= SECRET1;
+    b ^= seed;
+    Mum(&a, &b);
+    return Mix(a ^ SECRET0 ^ length, b ^ SECRET1);
+  }
+
+  /** @return the hash of a single 64-bit word, the fast path for 4-byte and 8-byte keys */
+  static inline hash_t HashWord(uint64_t word) {
+    uint64_t a = word ^ SECRET0;
+    uint64_t b = SECRET1;
+    Mum(&a, &b);
+    return Mix(a ^ SECRET0, b ^ SECRET1);
   }
 
   static inline hash_t CombineHashes(hash_t l, hash_t r) {
-    hash_t both[2] = {};
-    both[0] = l;
-    both[1] = r;
-    return HashBytes(reinterpret_cast<char *>(both), sizeof(hash_t) * 2);
+    uint64_t a = l ^ SECRET0;
+    uint64_t b = r ^ SECRET1;
+    Mum(&a, &b);
+    return Mix(a ^ SECRET0, b ^ SECRET1);
   }
 
   static inline hash_t SumHashes(hash_t l, hash_t r) { return (l % PRIME_FACTOR + r % PRIME_FACTOR) % PRIME_FACTOR; }
 
   template <typename T>
   static inline hash_t Hash(const T *ptr) {
-    return HashBytes(reinterpret_cast<const char *>(ptr), sizeof(T));
+    const auto *bytes = reinterpret_cast<const char *>(ptr);
+    if constexpr (sizeof(T) == 8) {
+      return HashWord(Read8(bytes));
+    } else if constexpr (sizeof(T) == 4) {
+      return HashWord(Read4(bytes));
+    } else {
+      return HashBytes(bytes, sizeof(T));
+    }
   }
 
   template <typename T>
   static inline hash_t HashPtr(const T *ptr) {
-    return HashBytes(reinterpret_cast<const char *>(&ptr), sizeof(void *));
+    return HashWord(reinterpret_cast<uintptr_t>(ptr));
   }
 
   /** @return the hash of the value */
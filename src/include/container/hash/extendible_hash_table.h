@@ -18,6 +18,7 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/transaction.h"
+#include "container/hash/extendible_hash_table_iterator.h"
 #include "container/hash/hash_function.h"
 #include "storage/page/hash_table_bucket_page.h"
 #include "storage/page/hash_table_directory_page.h"
@@ -74,6 +75,48 @@ class ExtendibleHashTable {
    */
   bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result);
 
+  /**
+   * Performs a batch of point queries on the hash table. The keys are grouped by
+   * their bucket page, so the directory and every touched bucket page are fetched once.
+   *
+   * @param transaction the current transaction
+   * @param keys the keys to look up
+   * @param[out] results the value(s) associated with each key, in the order of keys
+   * @return true if at least one value was found
+   */
+  bool GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                 std::vector<std::vector<ValueType>> *results);
+
+  /**
+   * Bulk-loads key-value pairs into the hash table.
+   *
+   * If the table is empty, the pairs are partitioned by the low bits of their hashes, the directory
+   * is presized to the final global depth and every bucket page is written exactly once. Otherwise
+   * (or for pairs that do not fit even at the maximum depth) this falls back to Insert.
+   *
+   * The pairs are expected to be distinct, e.g. keys paired with the RIDs of a table heap.
+   *
+   * @param transaction the current transaction
+   * @param items the key-value pairs to load
+   * @return true if all pairs were inserted, false otherwise
+   */
+  bool BulkLoad(Transaction *transaction, const std::vector<MappingType> &items);
+
+  /**
+   * @return an iterator over all key-value pairs, visiting each bucket page once
+   */
+  HASH_TABLE_ITERATOR_TYPE Begin();
+
+  /**
+   * Splits a full scan into iterators over disjoint, contiguous ranges of directory slots so that
+   * the partitions can be consumed in parallel. All partitions come from the same directory
+   * snapshot, so together they visit every bucket page exactly once.
+   *
+   * @param num_partitions the number of iterators to create
+   * @return one iterator per directory range; some may be empty
+   */
+  std::vector<HASH_TABLE_ITERATOR_TYPE> BeginPartitions(uint32_t num_partitions);
+
   /**
    * Returns the global depth.  Do not touch.
    */
@@ -136,6 +179,17 @@ class ExtendibleHashTable {
    */
   HASH_TABLE_BUCKET_TYPE *FetchBucketPage(page_id_t bucket_page_id);
 
+  /**
+   * Collects the bucket pages of the directory slots in [begin, end), each at most once.
+   * A bucket with local depth d is reported only for its lowest slot, which is below 2^d.
+   *
+   * @param dir_page a pointer to the hash table's directory page
+   * @param begin first directory slot of the range
+   * @param end one past the last directory slot of the range
+   * @return the distinct bucket page_ids in slot order
+   */
+  std::vector<page_id_t> DistinctBucketPageIds(HashTableDirectoryPage *dir_page, uint32_t begin, uint32_t end);
+
   /**
    * Performs insertion with an optional bucket splitting.
    *
@@ -161,6 +215,16 @@ class ExtendibleHashTable {
    */
   void Merge(Transaction *transaction, const KeyType &key, const ValueType &value);
 
+  /**
+   * Writes the pairs of an empty table into freshly allocated bucket pages and points the
+   * directory at them. The caller must hold the table latch in write mode.
+   *
+   * @param items the key-value pairs to load
+   * @param[out] overflow pairs that did not fit into their bucket at the maximum depth
+   * @return false if the buffer pool ran out of pages, in which case the table is left unchanged
+   */
+  bool BulkLoadEmpty(const std::vector<MappingType> &items, std::vector<MappingType> *overflow);
+
   // member variables
   page_id_t directory_page_id_;
   BufferPoolManager *buffer_pool_manager_;
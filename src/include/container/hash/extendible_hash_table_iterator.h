@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table_iterator.h
+//
+// Identification: src/include/container/hash/extendible_hash_table_iterator.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rwlatch.h"
+#include "storage/page/hash_table_bucket_page.h"
+#include "storage/page/hash_table_directory_page.h"
+
+namespace bustub {
+
+#define HASH_TABLE_ITERATOR_TYPE ExtendibleHashTableIterator<KeyType, ValueType, KeyComparator>
+
+/**
+ * Full-scan iterator over an extendible hash table.
+ *
+ * The iterator works one bucket at a time: it copies the readable pairs of a bucket page
+ * under the table's read latch and unpins the page before handing them out, so no page
+ * stays pinned between calls. The set of buckets is taken from a snapshot of the directory
+ * when the iterator is created, with each bucket page listed once no matter how many
+ * directory slots point to it; a bucket that a merge has removed from the directory since
+ * is skipped. Pairs inserted or moved by a split or merge after that point may be missed or
+ * seen twice; callers that need an exact scan must keep writers out.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class ExtendibleHashTableIterator {
+ public:
+  /**
+   * Creates an iterator over the given bucket pages.
+   *
+   * @param buffer_pool_manager buffer pool manager of the hash table
+   * @param table_latch the hash table's latch, taken in read mode while a bucket is copied
+   * @param directory_page_id the hash table's directory page, checked for each bucket before it is read
+   * @param bucket_page_ids the distinct bucket pages to visit, in order
+   */
+  ExtendibleHashTableIterator(BufferPoolManager *buffer_pool_manager, ReaderWriterLatch *table_latch,
+                              page_id_t directory_page_id, std::vector<page_id_t> bucket_page_ids);
+
+  /**
+   * @return true if every pair of every bucket has been visited
+   */
+  bool IsEnd();
+
+  /**
+   * @return the current key-value pair
+   */
+  const MappingType &operator*();
+
+  /**
+   * Advances to the next pair, loading the next non-empty bucket if needed.
+   */
+  ExtendibleHashTableIterator &operator++();
+
+ private:
+  /**
+   * Copies the pairs of the next non-empty bucket still in the directory into items_.
+   * @throw Exception if the directory page or the bucket page cannot be fetched
+   */
+  void LoadNextBucket();
+
+  BufferPoolManager *buffer_pool_manager_;
+  ReaderWriterLatch *table_latch_;
+  page_id_t directory_page_id_;
+  std::vector<page_id_t> bucket_page_ids_;
+  // next bucket in bucket_page_ids_ to load
+  size_t next_bucket_{0};
+  // pairs of the current bucket
+  std::vector<MappingType> items_;
+  size_t item_index_{0};
+};
+
+}  // namespace bustub
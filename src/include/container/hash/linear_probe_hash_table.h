@@ -26,12 +26,17 @@
 
 namespace bustub {
 
-#define HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
+#define LINEAR_PROBE_HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
 
 /**
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * Resizing is incremental: growing the table allocates a new header page and
+ * new block pages, and every subsequent insert or remove migrates one block of
+ * the old layout into the new one. While a migration is in progress, lookups
+ * probe both layouts, so there is never a stop-the-world rehash.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
@@ -76,6 +81,7 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
 
   /**
    * Resizes the table to at least twice the initial size provided.
+   * A resize already in progress is completed first; the new one is migrated incrementally.
    * @param initial_size the initial size of the hash table
    */
   void Resize(size_t initial_size);
@@ -86,17 +92,100 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
    */
   size_t GetSize();
 
+  /**
+   * @return true if the table is migrating entries from an old layout
+   */
+  bool IsResizing();
+
  private:
+  /**
+   * Fetches a header page from the buffer pool manager.
+   *
+   * @param header_page_id the page_id to fetch
+   * @return a pointer to the header page
+   */
+  HashTableHeaderPage *FetchHeaderPage(page_id_t header_page_id);
+
+  /**
+   * Fetches a block page from the buffer pool manager.
+   *
+   * @param block_page_id the page_id to fetch
+   * @return a pointer to the block page
+   */
+  HASH_TABLE_BLOCK_TYPE *FetchBlockPage(page_id_t block_page_id);
+
+  /**
+   * Allocates a header page and enough block pages for num_buckets slots.
+   *
+   * @param num_buckets number of slots in the layout
+   * @return the page_id of the new header page
+   */
+  page_id_t CreateLayout(size_t num_buckets);
+
+  /**
+   * Deletes a header page and all of its block pages.
+   *
+   * @param header_page_id the header page of the layout
+   */
+  void DeleteLayout(page_id_t header_page_id);
+
+  /**
+   * Walks the probe sequence of key in the layout rooted at header_page_id. Every slot is passed
+   * to visit(block_page, offset, &dirty) until visit returns true, an unoccupied slot has been
+   * visited, or all slots have been visited.
+   *
+   * @param header_page_id the header page of the layout to probe
+   * @param key the key whose probe sequence is walked
+   * @param visit the callback invoked for every slot
+   */
+  template <typename Visitor>
+  void Probe(page_id_t header_page_id, const KeyType &key, Visitor &&visit);
+
+  /**
+   * Inserts a key-value pair into the first free slot of its probe sequence in the given layout.
+   *
+   * @return true if inserted, false if the pair already exists or the layout is full
+   */
+  bool InsertIntoLayout(page_id_t header_page_id, const KeyType &key, const ValueType &value);
+
+  /**
+   * @return true if the given layout contains the key-value pair
+   */
+  bool LayoutContains(page_id_t header_page_id, const KeyType &key, const ValueType &value);
+
+  /**
+   * Starts migrating all entries into a new layout with num_buckets slots.
+   * The caller must hold the table latch in write mode.
+   *
+   * @param num_buckets number of slots in the new layout
+   */
+  void StartResize(size_t num_buckets);
+
+  /**
+   * Migrates one block of the old layout into the current layout, and drops the
+   * old layout once it has been fully migrated. The caller must hold the table latch in write mode.
+   */
+  void MigrateStep();
+
   // member variable
   page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Readers are lookups, writers are inserts and removes since they also migrate entries during a resize
   ReaderWriterLatch table_latch_;
 
   // Hash function
   HashFunction<KeyType> hash_fn_;
+
+  // header page of the layout being migrated away from, INVALID_PAGE_ID if no resize is in progress
+  page_id_t old_header_page_id_{INVALID_PAGE_ID};
+  // next slot of the old layout to be migrated
+  size_t migrate_index_{0};
+  // occupied slots (including tombstones) of the current layout
+  size_t num_occupied_{0};
+  // live key-value pairs in both layouts
+  size_t num_items_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter.h
+//
+// Identification: src/include/execution/bloom_filter.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/column.h"
+#include "common/util/hash_util.h"
+#include "storage/table/tuple_filter.h"
+
+namespace bustub {
+
+/**
+ * BloomFilter is a blocked Bloom filter over hashes: a key sets one bit in
+ * each of the eight words of a 32-byte block chosen by its hash, so a lookup
+ * touches a single cache line. At BITS_PER_KEY bits a key, about 1% of the
+ * absent keys get through.
+ */
+class BloomFilter {
+ public:
+  /** The bits of filter per expected key */
+  static constexpr std::size_t BITS_PER_KEY = 10;
+
+  /** @param num_keys The number of keys the filter is sized for */
+  explicit BloomFilter(std::size_t num_keys);
+
+  /** Add a key, given as its hash. */
+  void Insert(hash_t hash);
+
+  /** @return `false` if the key with the given hash was never inserted, `true` if it may have been */
+  bool MayContain(hash_t hash) const;
+
+ private:
+  using Block = std::array<uint32_t, 8>;
+
+  /** @return The block of the key with the given hash */
+  std::size_t GetBlockIdx(hash_t hash) const { return ((hash >> 32) * blocks_.size()) >> 32; }
+
+  /** @return The bit the key with the given hash sets in each word of its block */
+  static Block GetMask(hash_t hash);
+
+  std::vector<Block> blocks_;
+};
+
+/**
+ * BloomTupleFilter lets through the tuples whose value of a column may be in
+ * a BloomFilter, reading the column straight from the serialized tuple, and
+ * then passes them on to another filter, if any.
+ */
+class BloomTupleFilter : public TupleFilter {
+ public:
+  /**
+   * @param bloom_filter The filter over the hashes (HashUtil::HashValue) of the values to let through
+   * @param column The column of the tuples to check
+   * @param next The filter to check the tuples that get through with, may be nullptr
+   */
+  BloomTupleFilter(std::shared_ptr<const BloomFilter> bloom_filter, const Column &column,
+                   std::unique_ptr<TupleFilter> next = nullptr)
+      : bloom_filter_(std::move(bloom_filter)), column_(column), next_(std::move(next)) {}
+
+  bool Matches(const char *data) const override;
+
+ private:
+  std::shared_ptr<const BloomFilter> bloom_filter_;
+  Column column_;
+  std::unique_ptr<TupleFilter> next_;
+};
+
+}  // namespace bustub
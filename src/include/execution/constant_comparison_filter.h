@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// constant_comparison_filter.h
+//
+// Identification: src/include/execution/constant_comparison_filter.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "storage/table/tuple_filter.h"
+
+namespace bustub {
+
+/**
+ * ConstantComparisonFilter compares a fixed-length column of a serialized
+ * tuple with a constant of the same type, reading the column straight from
+ * the page instead of deserializing a Value. T is the C++ type the column is
+ * stored as.
+ *
+ * A NULL column matches, so that the predicate it was made from, which is
+ * still evaluated on the tuples that get through, decides what to do with it.
+ */
+template <typename T>
+class ConstantComparisonFilter : public TupleFilter {
+ public:
+  ConstantComparisonFilter(uint32_t offset, ComparisonType comp_type, T constant, T null_value)
+      : offset_(offset), comp_type_(comp_type), constant_(constant), null_value_(null_value) {}
+
+  bool Matches(const char *data) const override {
+    T value;
+    memcpy(&value, data + offset_, sizeof(T));
+    if (value == null_value_) {
+      return true;
+    }
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        return value == constant_;
+      case ComparisonType::NotEqual:
+        return value != constant_;
+      case ComparisonType::LessThan:
+        return value < constant_;
+      case ComparisonType::LessThanOrEqual:
+        return value <= constant_;
+      case ComparisonType::GreaterThan:
+        return value > constant_;
+      case ComparisonType::GreaterThanOrEqual:
+        return value >= constant_;
+    }
+    return true;
+  }
+
+ private:
+  uint32_t offset_;
+  ComparisonType comp_type_;
+  T constant_;
+  T null_value_;
+};
+
+/**
+ * Make a filter that a table scan can run on the raw bytes of its tuples.
+ * @param predicate The scan predicate, evaluated on tuples of schema; may be nullptr
+ * @param schema The schema of the table
+ * @return A filter for predicate if it compares a fixed-length column with a non-NULL constant of the same type,
+ * nullptr otherwise
+ */
+std::unique_ptr<TupleFilter> MakeConstantComparisonFilter(const AbstractExpression *predicate, const Schema *schema);
+
+}  // namespace bustub
@@ -20,6 +20,7 @@
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 namespace bustub {
 
@@ -55,13 +56,14 @@ class ExecutionEngine {
     // Prepare the root executor
     executor->Init();
 
-    // Execute the query plan
+    // Execute the query plan, a batch at a time
     try {
-      Tuple tuple;
-      RID rid;
-      while (executor->Next(&tuple, &rid)) {
+      TupleBatch batch;
+      while (executor->NextBatch(&batch)) {
         if (result_set != nullptr && !NoModifyResultSet(plan)) {
-          result_set->push_back(tuple);
+          for (uint32_t row : batch.GetSelection()) {
+            result_set->push_back(batch.GetTuple(row));
+          }
         }
       }
     } catch (Exception &e) {
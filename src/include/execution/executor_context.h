@@ -60,6 +60,18 @@ class ExecutorContext {
   /** @return the transaction manager */
   TransactionManager *GetTransactionManager() { return txn_mgr_; }
 
+  /** @return the number of threads the query may run its parallel pipelines on */
+  std::size_t GetParallelism() const { return parallelism_; }
+
+  /** Set the number of threads the query may run its parallel pipelines on; 1 runs it all on the calling thread */
+  void SetParallelism(std::size_t parallelism) { parallelism_ = parallelism; }
+
+  /** @return the number of bytes each operator of the query may hold in memory before spilling, 0 if unlimited */
+  std::size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** Set the number of bytes each operator of the query may hold in memory before spilling; 0 lifts the limit */
+  void SetMemoryBudget(std::size_t memory_budget) { memory_budget_ = memory_budget; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +83,10 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The degree of parallelism of the query */
+  std::size_t parallelism_{1};
+  /** The memory budget of an operator of the query, in bytes */
+  std::size_t memory_budget_{0};
 };
 
 }  // namespace bustub
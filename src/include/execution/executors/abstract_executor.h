@@ -12,12 +12,17 @@
 
 #pragma once
 
+#include <memory>
+
+#include "execution/bloom_filter.h"
 #include "execution/executor_context.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 /**
- * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
+ * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model,
+ * and its batch-at-a-time variant through NextBatch().
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
  */
@@ -46,6 +51,34 @@ class AbstractExecutor {
    */
   virtual bool Next(Tuple *tuple, RID *rid) = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor. An executor is drained
+   * either through Next() or through NextBatch(), never both. The default
+   * fills the batch by calling Next(); executors that can do better override it.
+   * @param[out] batch The batch to fill with rows laid out as GetOutputSchema(); it is reset first
+   * @return `true` if the batch holds at least one selected row, `false` if there are no more tuples
+   */
+  virtual bool NextBatch(TupleBatch *batch) {
+    Tuple tuple;
+    RID rid;
+    batch->Reset(GetOutputSchema());
+    while (!batch->IsFull() && Next(&tuple, &rid)) {
+      batch->AppendTuple(tuple, rid);
+    }
+    return !batch->IsEmpty();
+  }
+
+  /**
+   * Let this executor drop, as early as it can, the rows whose col_idx'th
+   * output column is not in a BloomFilter, such as rows that a hash join above
+   * it would find no match for. Must be called before Init(); the default
+   * ignores the filter.
+   * @param col_idx The output column the filter is over
+   * @param filter The filter over the hashes (HashUtil::HashValue) of the values to keep
+   * @return `true` if the executor drops rows the filter rules out
+   */
+  virtual bool PushDownBloomFilter(uint32_t col_idx, std::shared_ptr<const BloomFilter> filter) { return false; }
+
   /** @return The schema of the tuples that this executor produces */
   virtual const Schema *GetOutputSchema() = 0;
 
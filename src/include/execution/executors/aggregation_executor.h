@@ -21,6 +21,7 @@
 #include "container/hash/hash_function.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/executors/seq_scan_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
 #include "storage/table/tuple.h"
@@ -108,6 +109,38 @@ class SimpleAggregationHashTable {
     CombineAggregateValues(&ht_[agg_key], agg_val);
   }
 
+  /**
+   * Merges the groups of another table, built from different input, into this one.
+   * @param other The table to merge, with the same aggregations as this one
+   */
+  void Merge(const SimpleAggregationHashTable &other) {
+    for (const auto &[agg_key, agg_val] : other.ht_) {
+      auto it = ht_.find(agg_key);
+      if (it == ht_.end()) {
+        ht_.insert({agg_key, agg_val});
+        continue;
+      }
+      for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+        auto &result = it->second.aggregates_[i];
+        switch (agg_types_[i]) {
+          case AggregationType::CountAggregate:
+          case AggregationType::SumAggregate:
+            // Counts and sums add up.
+            result = result.Add(agg_val.aggregates_[i]);
+            break;
+          case AggregationType::MinAggregate:
+            // The min of mins.
+            result = result.Min(agg_val.aggregates_[i]);
+            break;
+          case AggregationType::MaxAggregate:
+            // The max of maxes.
+            result = result.Max(agg_val.aggregates_[i]);
+            break;
+        }
+      }
+    }
+  }
+
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
@@ -178,6 +211,13 @@ class AggregationExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of groups from the aggregation.
+   * @param[out] batch The next batch produced by the aggregation
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the aggregation */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
@@ -185,6 +225,30 @@ class AggregationExecutor : public AbstractExecutor {
   const AbstractExecutor *GetChildExecutor() const;
 
  private:
+  /** Combine the selected rows of batch, produced by the child, into aht */
+  void AggregateBatch(const TupleBatch &batch, SimpleAggregationHashTable *aht);
+
+  /** Build aht_ from a parallel scan, each worker aggregating its morsels into a table of its own */
+  void AggregateInParallel(SeqScanExecutor *scan);
+
+  /** @return `true` if the group under aht_iterator_ passes the HAVING clause */
+  bool MatchesHaving() {
+    return plan_->GetHaving() == nullptr ||
+           plan_->GetHaving()
+               ->EvaluateAggregate(aht_iterator_.Key().group_bys_, aht_iterator_.Val().aggregates_)
+               .GetAs<bool>();
+  }
+
+  /** @return The output values of the group under aht_iterator_ */
+  std::vector<Value> MakeOutputValues() {
+    std::vector<Value> values;
+    for (auto &output_column : plan_->OutputSchema()->GetColumns()) {
+      values.push_back(
+          output_column.GetExpr()->EvaluateAggregate(aht_iterator_.Key().group_bys_, aht_iterator_.Val().aggregates_));
+    }
+    return values;
+  }
+
   /** @return The tuple as an AggregateKey */
   AggregateKey MakeAggregateKey(const Tuple *tuple) {
     std::vector<Value> keys;
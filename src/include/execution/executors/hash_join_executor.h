@@ -21,12 +21,34 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/radix_join.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes a hash JOIN on two tables. Init() builds a hash
+ * table from the left child; Next() and NextBatch() then stream the right
+ * child through it, so only the build side is held in memory and a parent
+ * that stops pulling early, such as a LIMIT, stops the probe too.
+ *
+ * The hash table is split into SPILL_PARTITIONS partitions by join key. When
+ * the build side outgrows the memory budget of the query, the largest
+ * partitions are spilled to TmpTupleFiles until the rest fits (a hybrid hash
+ * join): right tuples whose partition is in memory are joined as they stream
+ * by, the others are spilled too, and once the right child is exhausted the
+ * spilled partitions are read back and joined one at a time. A spilled
+ * partition is read back whole, so the budget should hold at least one
+ * partition's share of the build side.
+ *
+ * With a degree of parallelism above 1 and no memory budget, the join is a
+ * parallel radix join instead: Init() reads both children into memory and
+ * partitions them with a RadixJoin, and the partitions are joined as the
+ * output is pulled, as many at a time as there are threads. So only the
+ * matches of those partitions are held at once, and a parent that stops
+ * early stops the join too; but both sides are in memory, not just the
+ * build side.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -51,10 +73,27 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch from the join, probing the hash table with a batch of right tuples at a time.
+   * @param[out] batch The next batch produced by the join
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the join */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
  private:
+  /** A partition of the hash table, with the files its tuples go to once it is spilled. */
+  struct Partition {
+    std::unordered_map<HashJoinKey, std::vector<Tuple>> ht_;
+    /** The estimated size of ht_ in bytes */
+    std::size_t size_{0};
+    /** The spilled left and right tuples, nullptr while the partition is in memory */
+    std::unique_ptr<TmpTupleFile> left_file_;
+    std::unique_ptr<TmpTupleFile> right_file_;
+  };
+
   HashJoinKey GetLeftJoinKey(const Tuple *tuple) {
     return {plan_->LeftJoinKeyExpression()->Evaluate(tuple, left_executor_->GetOutputSchema())};
   }
@@ -63,6 +102,65 @@ class HashJoinExecutor : public AbstractExecutor {
     return {plan_->RightJoinKeyExpression()->Evaluate(tuple, right_executor_->GetOutputSchema())};
   }
 
+  /** @return The partition that the tuples with the given join key go to */
+  Partition *GetPartition(const HashJoinKey &key) {
+    return &partitions_[std::hash<HashJoinKey>()(key) % partitions_.size()];
+  }
+
+  /** Add a left tuple to the hash table, spilling partitions if that takes it over the memory budget. */
+  void Build(const HashJoinKey &key, const Tuple &tuple);
+
+  /** Spill the largest partition that is still in memory. */
+  void SpillLargestPartition();
+
+  /** @return The left tuples in memory that match the given join key, nullptr if there are none */
+  const std::vector<Tuple> *FindMatches(const HashJoinKey &key);
+
+  /**
+   * Read the next right tuple to probe with into right_tuple_, from the right child and then from the spilled
+   * partitions; right tuples of partitions that are spilled meanwhile are spilled as they are read.
+   * @param[out] key The join key of the tuple
+   * @return `false` if there are no more right tuples
+   */
+  bool NextRightTuple(HashJoinKey *key);
+
+  /**
+   * Read the next batch of right rows to probe with into probe_batch_ and their join keys into probe_keys_, the
+   * same way as NextRightTuple(). A batch may end up with no rows selected.
+   * @return `false` if there are no more right rows
+   */
+  bool NextRightBatch();
+
+  /**
+   * Read the next page of right tuples of the spilled partitions into spill_tuples_, loading the next spilled
+   * partition into memory (and dropping the one before) when the current one is done.
+   * @return `false` if all the spilled partitions have been joined
+   */
+  bool NextSpilledPage();
+
+  /** @return The output values of the join of left_tuple and right_tuple */
+  std::vector<Value> MakeOutputValues(const Tuple &left_tuple, const Tuple &right_tuple) const;
+
+  /** Read the right child and partition it and the left one, already read by Materialize(), with a RadixJoin. */
+  void RadixInit(std::vector<Value> left_keys, std::vector<RadixJoin::Entry> left_entries);
+
+  /**
+   * Read all the rows of a child.
+   * @param child The child executor
+   * @param key_expr The join key expression of the child's side
+   * @param[out] tuples The rows
+   * @param[out] keys The join keys of the rows
+   * @param[out] entries The hashes of the join keys, with the indexes of the rows
+   */
+  void Materialize(AbstractExecutor *child, const AbstractExpression *key_expr, std::vector<Tuple> *tuples,
+                   std::vector<Value> *keys, std::vector<RadixJoin::Entry> *entries);
+
+  /**
+   * Hand out the next match of the radix join, joining the next partitions when those joined so far are used up.
+   * @return `false` if all the matches have been handed out
+   */
+  bool NextRadixMatch(const Tuple **left_tuple, const Tuple **right_tuple);
+
  private:
   /** The NestedLoopJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
@@ -70,7 +168,11 @@ class HashJoinExecutor : public AbstractExecutor {
   std::unique_ptr<AbstractExecutor> left_executor_;
   std::unique_ptr<AbstractExecutor> right_executor_;
 
-  std::unordered_map<HashJoinKey, std::vector<Tuple>> ht_;
+  std::vector<Partition> partitions_;
+  /** The estimated size in bytes of the partitions in memory */
+  std::size_t memory_used_;
+  /** The spilled partitions, in the order they were spilled */
+  std::vector<Partition *> spilled_;
 
   /* output schema column cnt */
   uint32_t column_cnt_;
@@ -79,8 +181,43 @@ class HashJoinExecutor : public AbstractExecutor {
   /* It's not graceful, maybe better approach? */
   std::vector<uint32_t> left_or_right_;
 
-  std::vector<Tuple> res_;
-  std::vector<Tuple>::iterator res_iterator_;
+  /* the left tuples matching the right row being probed, and the next of them to join with it */
+  const std::vector<Tuple> *matches_;
+  std::size_t match_idx_;
+
+  /* whether the right child is exhausted, so that the right tuples now come from the spilled partitions */
+  bool right_done_;
+  /* the spilled partition being joined, the number of spilled partitions started, the next page of its right */
+  /* tuples, and the tuples of the current page with the next of them to probe */
+  Partition *joining_;
+  std::size_t spill_idx_;
+  std::size_t spill_page_;
+  std::vector<Tuple> spill_tuples_;
+  std::size_t spill_tuple_idx_;
+
+  /* Next() state: the right tuple being probed */
+  Tuple right_tuple_;
+
+  /* radix mode state: both inputs and their join keys, the partitioned join, the next partition to join, the */
+  /* matches of the partitions joined last, and the next of them to hand out */
+  bool radix_;
+  std::vector<Tuple> radix_left_;
+  std::vector<Tuple> radix_right_;
+  std::vector<Value> radix_left_keys_;
+  std::vector<Value> radix_right_keys_;
+  std::unique_ptr<RadixJoin> radix_join_;
+  std::size_t radix_next_partition_;
+  std::vector<RadixJoin::Matches> radix_matches_;
+  std::size_t radix_partition_;
+  std::size_t radix_match_;
+
+  /* NextBatch() state: the right batch being probed, its join keys and its output columns (right ones only), */
+  /* the next selected row to probe, and the row whose matches are being emitted */
+  TupleBatch probe_batch_;
+  std::vector<Value> probe_keys_;
+  std::vector<std::vector<Value>> probe_columns_;
+  uint32_t probe_row_;
+  uint32_t match_row_;
 };
 
 }  // namespace bustub
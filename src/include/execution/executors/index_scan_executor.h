@@ -12,9 +12,12 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "common/rid.h"
+#include "execution/bloom_filter.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
@@ -22,8 +25,12 @@
 
 namespace bustub {
 
+/** The number of leaves an index scan keeps fetching into the buffer pool ahead of the one it reads. */
+static constexpr int INDEX_SCAN_READ_AHEAD = 8;
+
 /**
- * IndexScanExecutor executes an index scan over a table.
+ * IndexScanExecutor executes an index scan over a table: it walks the range of the plan through a
+ * B+ tree index, in key order, and fetches the tuples from the table.
  */
 
 class IndexScanExecutor : public AbstractExecutor {
@@ -41,8 +48,24 @@ class IndexScanExecutor : public AbstractExecutor {
 
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /** The filter is checked on the raw tuples, before they are locked and read. */
+  bool PushDownBloomFilter(uint32_t col_idx, std::shared_ptr<const BloomFilter> filter) override;
+
  private:
+  /** Start the scan over index if it is a B+ tree over GenericKey<KeySize>. */
+  template <size_t KeySize>
+  bool InitScan(Index *index);
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  /** The table the index belongs to. */
+  TableInfo *table_info_{nullptr};
+  /** The filter pushed down by the parent, and the table column it is over; bloom_filter_ may be nullptr. */
+  std::shared_ptr<const BloomFilter> bloom_filter_;
+  uint32_t bloom_column_{0};
+  /** The check of bloom_filter_ on raw tuples, nullptr if there is none. */
+  std::unique_ptr<TupleFilter> filter_;
+  /** Yields the RIDs of the range in index order, false once the range is exhausted. */
+  std::function<bool(RID *)> next_rid_;
 };
 }  // namespace bustub
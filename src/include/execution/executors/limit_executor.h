@@ -45,6 +45,13 @@ class LimitExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch from the limit, cutting the child's batch short once the limit is reached.
+   * @param[out] batch The next batch produced by the limit
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the limit */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
@@ -25,6 +25,11 @@ namespace bustub {
 
 /**
  * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ *
+ * It is a block nested loop join: the left tuples are read into memory a
+ * block of GetBlockPages() pages' worth at a time, and every right tuple is
+ * joined with the whole block, so the right side is scanned once per block
+ * rather than once per left tuple.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -60,8 +65,18 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   std::unique_ptr<AbstractExecutor> left_executor_;
   std::unique_ptr<AbstractExecutor> right_executor_;
 
-  Tuple cur_left_;
-  bool is_dummy_left_;
+  /** Read the next block of left tuples, returning `false` if the left side is exhausted. */
+  bool NextLeftBlock();
+
+  /** The block of left tuples being joined */
+  std::vector<Tuple> left_block_;
+  /** The number of blocks read since Init() */
+  std::size_t block_count_;
+  /** The right tuple being joined with the block, if any */
+  Tuple right_tuple_;
+  bool has_right_;
+  /** The index in left_block_ of the next tuple to join with right_tuple_ */
+  std::size_t left_idx_;
 
   /* output schema column cnt */
   uint32_t column_cnt_;
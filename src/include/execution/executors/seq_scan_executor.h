@@ -12,18 +12,36 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
 #include <vector>
 
+#include "execution/bloom_filter.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/morsel_dispenser.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_filter.h"
 
 namespace bustub {
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ *
+ * With a parallelism above 1 in the executor context, NextBatch() runs
+ * morsel-driven: worker threads claim morsels of table pages from a shared
+ * MorselDispenser, filter and project them, and queue the resulting batches
+ * for NextBatch() to hand out, in no particular order. A parent that can
+ * itself work in parallel, such as AggregationExecutor, can instead call
+ * NextMorsel() from its own workers. Next() always scans serially.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -34,6 +52,9 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  /** Stops the scan's worker threads, if any. */
+  ~SeqScanExecutor() override;
+
   /** Initialize the sequential scan */
   void Init() override;
 
@@ -45,16 +66,83 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan. The predicate and
+   * the projection are evaluated on a batch of table rows at a time.
+   * @param[out] batch The next batch produced by the scan
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
 
+  /** The filter is checked on the raw tuples, with the constant comparisons of the predicate. */
+  bool PushDownBloomFilter(uint32_t col_idx, std::shared_ptr<const BloomFilter> filter) override;
+
+  /** @return The number of threads the scan runs on, 1 if it is serial */
+  std::size_t GetParallelism() const { return dispenser_ == nullptr ? 1 : exec_ctx_->GetParallelism(); }
+
+  /**
+   * Claim a morsel and filter and project its tuples; safe to call from
+   * several threads at once. Only for a parallel scan, and not together
+   * with NextBatch().
+   * @param[out] batch The morsel's qualifying tuples, which may be none or more than TUPLE_BATCH_SIZE
+   * @return `true` if a morsel was claimed, `false` if there are no more morsels
+   * @throws Exception if a page of the morsel cannot be read
+   */
+  bool NextMorsel(TupleBatch *batch);
+
  private:
+  /** Lock rid as the isolation level requires before reading it; thread-safe */
+  void LockRow(const RID &rid);
+
+  /** Release the lock on rid if the isolation level does not keep it; thread-safe */
+  void UnlockRow(const RID &rid);
+
+  /** Filter rows, which have the table schema, and project the survivors into batch */
+  bool FilterAndProject(TupleBatch *rows, TupleBatch *batch) const;
+
+  /** The body of a worker thread of a parallel NextBatch() */
+  void Work();
+
+  /** Stop and join the worker threads */
+  void StopWorkers();
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
 
   TableInfo *table_info_;
 
+  /** The filter pushed down by the parent, and the table column it is over; bloom_filter_ may be nullptr */
+  std::shared_ptr<const BloomFilter> bloom_filter_;
+  uint32_t bloom_column_{0};
+
+  /**
+   * What the table iterator checks on the raw tuples, the constant comparisons of the predicate and the pushed down
+   * filter; may be nullptr
+   */
+  std::unique_ptr<TupleFilter> filter_;
+
   TableIterator cur_;
   TableIterator end_;
+
+  /** Table rows read by NextBatch() before the predicate and projection */
+  TupleBatch scan_batch_;
+
+  /** Serializes the lock manager calls of the workers, which share the transaction's lock sets */
+  std::mutex lock_mutex_;
+
+  /* parallel scan state: the morsels, the worker threads, and the batches they produced but NextBatch() has not */
+  /* handed out yet, all guarded by queue_mutex_ */
+  std::unique_ptr<MorselDispenser> dispenser_;
+  std::vector<std::thread> workers_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<TupleBatch> queue_;
+  std::size_t running_workers_{0};
+  std::atomic<bool> stop_{false};
+  /** The first exception a worker ran into, rethrown by NextBatch() */
+  std::exception_ptr error_;
 };
 }  // namespace bustub
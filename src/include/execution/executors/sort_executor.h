@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.h
+//
+// Identification: src/include/execution/executors/sort_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/abstract_executor.h"
+#include "execution/loser_tree.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_file.h"
+
+namespace bustub {
+
+/**
+ * SortExecutor orders the tuples of its child executor, comparing the
+ * normalized binary keys of SortKeyEncoder instead of Values.
+ *
+ * The tuples are sorted in memory as long as they fit in the memory budget
+ * of the executor context. Past that, every time the budget fills up the
+ * tuples held are sorted and spilled to temporary pages as a run, and the
+ * output is a k-way merge of the runs through a loser tree, which reads
+ * one page of each run at a time. The keys are not spilled, but computed
+ * again as the pages of the runs are read back.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new SortExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The sort plan to be executed
+   * @param child_executor The child executor from which the tuples to sort are pulled
+   */
+  SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the sort, which pulls every tuple of the child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the sort.
+   * @param[out] tuple The next tuple produced by the sort
+   * @param[out] rid The next tuple RID produced by the sort
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch from the sort.
+   * @param[out] batch The next batch produced by the sort
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
+  /** @return The output schema for the sort */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** A sorted run spilled to temporary pages, with the page of it being merged */
+  struct Run {
+    std::unique_ptr<TmpTupleFile> file_;
+    /** The index of the next page to read */
+    std::size_t next_page_{0};
+    /** The tuples of the page being merged, in order, and their keys */
+    std::vector<Tuple> tuples_;
+    std::vector<std::string> keys_;
+    /** The index in tuples_ of the head of the run */
+    std::size_t head_{0};
+  };
+
+  /** @return The sort key of a tuple of the child */
+  std::string EncodeKey(const Tuple &tuple) const;
+
+  /** Sort the tuples held in memory into order_. */
+  void SortInMemory();
+
+  /** Sort the tuples held in memory and spill them as a new run. */
+  void SpillRun();
+
+  /**
+   * Read the next page of a run.
+   * @return `false` if the run is exhausted
+   */
+  bool ReadRunPage(Run *run);
+
+  /** @return The next tuple in order, nullptr once all of them are out; valid until the next call */
+  const Tuple *NextSortedTuple();
+
+  /** The sort plan node to be executed */
+  const SortPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  SortKeyEncoder encoder_;
+
+  /** The tuples held in memory and their keys */
+  std::vector<Tuple> tuples_;
+  std::vector<std::string> keys_;
+  /** The number of bytes held by tuples_ and keys_ */
+  std::size_t memory_used_{0};
+  /** The indexes in tuples_ in sorted order, and the next one to output, when nothing was spilled */
+  std::vector<uint32_t> order_;
+  std::size_t next_{0};
+
+  /** The spilled runs, merged by merge_ */
+  std::vector<Run> runs_;
+  std::unique_ptr<LoserTree> merge_;
+  /** Whether the tuple last output was the head of the winning run, which must move on before the next one */
+  bool advance_{false};
+};
+
+}  // namespace bustub
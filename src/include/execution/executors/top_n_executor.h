@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_executor.h
+//
+// Identification: src/include/execution/executors/top_n_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/top_n_plan.h"
+#include "execution/sort_key.h"
+
+namespace bustub {
+
+/**
+ * TopNExecutor produces the first n tuples of its child executor in ORDER BY
+ * order without sorting all of them: it keeps the n smallest sort keys seen
+ * so far in a max-heap, so that each tuple of the child either loses to the
+ * largest of them or replaces it. That takes O(rows * log n) time and holds
+ * only n tuples in memory. The sort keys are those of SortExecutor.
+ */
+class TopNExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new TopNExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The top-n plan to be executed
+   * @param child_executor The child executor from which tuples are pulled
+   */
+  TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /**
+   * Construct a new TopNExecutor instance that runs a limit above a sort.
+   * @param exec_ctx The executor context
+   * @param limit_plan The limit plan
+   * @param sort_plan The sort plan, the child of limit_plan
+   * @param child_executor The executor of the child of sort_plan
+   */
+  TopNExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *limit_plan, const SortPlanNode *sort_plan,
+               std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  /** Initialize the top-n, which pulls every tuple of the child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the top-n.
+   * @param[out] tuple The next tuple produced by the top-n
+   * @param[out] rid The next tuple RID produced by the top-n
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch from the top-n.
+   * @param[out] batch The next batch produced by the top-n
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
+  /** @return The output schema for the top-n */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** The plan made from a limit and a sort, if the executor was constructed from them */
+  std::unique_ptr<TopNPlanNode> fused_plan_;
+  /** The top-n plan node to be executed */
+  const TopNPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  SortKeyEncoder encoder_;
+
+  /** The tuples kept and their keys, at most n of each */
+  std::vector<Tuple> tuples_;
+  std::vector<std::string> keys_;
+  /**
+   * The indexes in tuples_ as a max-heap on their keys while the child is
+   * read, then in sorted order
+   */
+  std::vector<uint32_t> heap_;
+  /** The index in heap_ of the next tuple to output */
+  std::size_t next_{0};
+};
+
+}  // namespace bustub
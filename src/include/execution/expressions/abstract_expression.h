@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -58,6 +59,22 @@ class AbstractExpression {
    */
   virtual Value EvaluateAggregate(const std::vector<Value> &group_bys, const std::vector<Value> &aggregates) const = 0;
 
+  /**
+   * Evaluates this expression on every selected row of a batch. The default
+   * materializes each row and calls Evaluate; expressions that can work on
+   * whole columns override it.
+   * @param batch The batch, whose rows have the schema this expression refers to
+   * @param[out] result One value per selected row, in selection order
+   */
+  virtual void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *result) const {
+    result->clear();
+    result->reserve(batch.Size());
+    for (uint32_t row : batch.GetSelection()) {
+      Tuple tuple = batch.GetTuple(row);
+      result->push_back(Evaluate(&tuple, batch.GetSchema()));
+    }
+  }
+
   /** @return the child_idx'th child of this expression */
   const AbstractExpression *GetChildAt(uint32_t child_idx) const { return children_[child_idx]; }
 
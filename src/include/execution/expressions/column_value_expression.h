@@ -45,6 +45,15 @@ class ColumnValueExpression : public AbstractExpression {
     BUSTUB_ASSERT(false, "Aggregation should only refer to group-by and aggregates.");
   }
 
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *result) const override {
+    const std::vector<Value> &column = batch.GetColumn(col_idx_);
+    result->clear();
+    result->reserve(batch.Size());
+    for (uint32_t row : batch.GetSelection()) {
+      result->push_back(column[row]);
+    }
+  }
+
   uint32_t GetTupleIdx() const { return tuple_idx_; }
   uint32_t GetColIdx() const { return col_idx_; }
 
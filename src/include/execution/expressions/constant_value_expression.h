@@ -36,6 +36,13 @@ class ConstantValueExpression : public AbstractExpression {
     return val_;
   }
 
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *result) const override {
+    result->assign(batch.Size(), val_);
+  }
+
+  /** @return The constant this expression evaluates to */
+  const Value &GetValue() const { return val_; }
+
  private:
   Value val_;
 };
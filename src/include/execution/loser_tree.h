@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree.h
+//
+// Identification: src/include/execution/loser_tree.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * LoserTree picks the run with the smallest head among the k sorted runs of
+ * a k-way merge. Each inner node of the tree remembers the loser of the
+ * match played there, so when the winning run moves on to its next element
+ * only the log2(k) matches on its path to the root are replayed, one
+ * comparison each; a binary heap needs about twice as many.
+ *
+ * The tree does not see the runs, only compares them through a callback.
+ */
+class LoserTree {
+ public:
+  /**
+   * Whether the head of run a comes before the head of run b. A run that is
+   * exhausted must come after every run that is not.
+   */
+  using Less = std::function<bool(std::size_t a, std::size_t b)>;
+
+  /**
+   * Play the matches between the heads of the runs.
+   * @param num_runs The number of runs, at least 1
+   * @param less Compares the heads of two runs
+   */
+  LoserTree(std::size_t num_runs, Less less) : num_runs_(num_runs), less_(std::move(less)), tree_(num_runs, 0) {
+    // leaf i sits at node num_runs + i, and the children of node n at 2n and 2n + 1
+    std::vector<std::size_t> winners(2 * num_runs);
+    for (std::size_t i = 0; i < num_runs; i++) {
+      winners[num_runs + i] = i;
+    }
+    for (std::size_t node = num_runs - 1; node > 0; node--) {
+      std::size_t winner = winners[2 * node];
+      std::size_t loser = winners[2 * node + 1];
+      if (less_(loser, winner)) {
+        std::swap(winner, loser);
+      }
+      winners[node] = winner;
+      tree_[node] = loser;
+    }
+    tree_[0] = num_runs > 1 ? winners[1] : 0;
+  }
+
+  /** @return The run with the smallest head */
+  std::size_t GetWinner() const { return tree_[0]; }
+
+  /** Find the new winner after the head of the winning run has changed. */
+  void Replay() {
+    std::size_t winner = tree_[0];
+    for (std::size_t node = (num_runs_ + winner) / 2; node > 0; node /= 2) {
+      if (less_(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  std::size_t num_runs_;
+  Less less_;
+  /** The loser of the match at each inner node 1..num_runs - 1, and the overall winner at 0 */
+  std::vector<std::size_t> tree_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_dispenser.h
+//
+// Identification: src/include/execution/morsel_dispenser.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * MorselDispenser hands out the pages of a table to the workers of a
+ * parallel scan, a morsel (a run of consecutive pages) at a time. Workers
+ * that finish their morsels early just claim more, so the load balances
+ * itself however the qualifying tuples are spread over the table.
+ */
+class MorselDispenser {
+ public:
+  /**
+   * @param page_ids The pages to hand out, in order
+   * @param morsel_size The number of pages in a morsel
+   */
+  explicit MorselDispenser(std::vector<page_id_t> page_ids, std::size_t morsel_size = MORSEL_SIZE)
+      : page_ids_(std::move(page_ids)), morsel_size_(morsel_size) {}
+
+  /**
+   * Claim the next morsel; safe to call from several threads at once.
+   * @param[out] morsel The pages of the claimed morsel
+   * @return `true` if a morsel was claimed, `false` if all of them are gone
+   */
+  bool Next(std::vector<page_id_t> *morsel) {
+    std::size_t first = next_.fetch_add(morsel_size_);
+    if (first >= page_ids_.size()) {
+      return false;
+    }
+    std::size_t last = std::min(first + morsel_size_, page_ids_.size());
+    morsel->assign(page_ids_.begin() + first, page_ids_.begin() + last);
+    return true;
+  }
+
+ private:
+  const std::vector<page_id_t> page_ids_;
+  const std::size_t morsel_size_;
+  /** The index in page_ids_ of the first page of the next morsel */
+  std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace bustub
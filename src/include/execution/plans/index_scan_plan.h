@@ -12,13 +12,17 @@
 
 #pragma once
 
+#include <optional>
+
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 
 namespace bustub {
 /**
- * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ * IndexScanPlanNode identifies a table that should be scanned through one of its B+ tree indexes,
+ * with an optional predicate. The scan may be limited to a range of index keys and visit the keys
+ * in ascending or descending order.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
@@ -27,10 +31,20 @@ class IndexScanPlanNode : public AbstractPlanNode {
    * @param output the output format of this scan plan node
    * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) == true or predicate ==
    * nullptr
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to scan
+   * @param low_key if given, the scan starts at this key (in the key schema of the index)
+   * @param high_key if given, the scan stops after this key (in the key schema of the index)
+   * @param reverse whether to scan from the high key down to the low key
    */
-  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid)
-      : AbstractPlanNode(output, {}), predicate_{predicate}, index_oid_(index_oid) {}
+  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid,
+                    std::optional<Tuple> low_key = std::nullopt, std::optional<Tuple> high_key = std::nullopt,
+                    bool reverse = false)
+      : AbstractPlanNode(output, {}),
+        predicate_{predicate},
+        index_oid_(index_oid),
+        low_key_(std::move(low_key)),
+        high_key_(std::move(high_key)),
+        reverse_(reverse) {}
 
   PlanType GetType() const override { return PlanType::IndexScan; }
 
@@ -40,11 +54,25 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** @return the identifier of the table that should be scanned */
   index_oid_t GetIndexOid() const { return index_oid_; }
 
+  /** @return the smallest index key to return, if any */
+  const std::optional<Tuple> &GetLowKey() const { return low_key_; }
+
+  /** @return the greatest index key to return, if any */
+  const std::optional<Tuple> &GetHighKey() const { return high_key_; }
+
+  /** @return whether the keys are visited in descending order */
+  bool IsReverse() const { return reverse_; }
+
  private:
   /** The predicate that all returned tuples must satisfy. */
   const AbstractExpression *predicate_;
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
+  /** Bounds of the scan, both inclusive. */
+  std::optional<Tuple> low_key_;
+  std::optional<Tuple> high_key_;
+  /** Whether to scan in descending key order. */
+  bool reverse_;
 };
 
 }  // namespace bustub
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/config.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 
@@ -32,10 +33,11 @@ class NestedLoopJoinPlanNode : public AbstractPlanNode {
    * @param children Two sequential scan children plans
    * @param predicate The predicate to join with, the tuples are joined
    * if predicate(tuple) = true or predicate = `nullptr`
+   * @param block_pages The number of pages' worth of left tuples joined with each scan of the right side
    */
   NestedLoopJoinPlanNode(const Schema *output_schema, std::vector<const AbstractPlanNode *> &&children,
-                         const AbstractExpression *predicate)
-      : AbstractPlanNode(output_schema, std::move(children)), predicate_(predicate) {}
+                         const AbstractExpression *predicate, std::size_t block_pages = NLJ_BLOCK_PAGES)
+      : AbstractPlanNode(output_schema, std::move(children)), predicate_(predicate), block_pages_(block_pages) {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::NestedLoopJoin; }
@@ -43,6 +45,9 @@ class NestedLoopJoinPlanNode : public AbstractPlanNode {
   /** @return The predicate to be used in the nested loop join */
   const AbstractExpression *Predicate() const { return predicate_; }
 
+  /** @return The number of pages' worth of left tuples joined with each scan of the right side */
+  std::size_t GetBlockPages() const { return block_pages_; }
+
   /** @return The left plan node of the nested loop join, by convention it should be the smaller table */
   const AbstractPlanNode *GetLeftPlan() const {
     BUSTUB_ASSERT(GetChildren().size() == 2, "Nested loop joins should have exactly two children plans.");
@@ -58,6 +63,8 @@ class NestedLoopJoinPlanNode : public AbstractPlanNode {
  private:
   /** The join predicate */
   const AbstractExpression *predicate_;
+  /** The size of a block of left tuples, in pages */
+  std::size_t block_pages_;
 };
 
 }  // namespace bustub
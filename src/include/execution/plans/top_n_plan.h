@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// top_n_plan.h
+//
+// Identification: src/include/execution/plans/top_n_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/sort_plan.h"
+
+namespace bustub {
+
+/**
+ * TopN produces the first n tuples of its child in the order of a list of
+ * ORDER BY expressions, which is what a Limit above a Sort produces.
+ */
+class TopNPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new TopNPlanNode instance.
+   * @param output_schema The output schema of the top-n, which is the schema of its child
+   * @param child The child plan from which tuples are obtained
+   * @param order_bys The ORDER BY expressions, evaluated on the child's tuples, with their directions
+   * @param n The number of output tuples
+   */
+  TopNPlanNode(const Schema *output_schema, const AbstractPlanNode *child,
+               std::vector<std::pair<OrderByType, const AbstractExpression *>> order_bys, std::size_t n)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)), n_(n) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::TopN; }
+
+  /** @return The ORDER BY expressions, with their directions */
+  const std::vector<std::pair<OrderByType, const AbstractExpression *>> &GetOrderBys() const { return order_bys_; }
+
+  /** @return The number of output tuples */
+  std::size_t GetN() const { return n_; }
+
+  /** @return The child plan node */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "TopN should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+ private:
+  /** The ORDER BY expressions, with their directions */
+  std::vector<std::pair<OrderByType, const AbstractExpression *>> order_bys_;
+  /** The number of output tuples */
+  std::size_t n_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// radix_join.h
+//
+// Identification: src/include/execution/radix_join.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+
+namespace bustub {
+
+/**
+ * RadixJoin is the in-memory core of a parallel radix hash join.
+ *
+ * Both inputs come in as the hashes of their join keys. RadixJoin partitions
+ * them on the low bits of the hash, in as many passes as it takes for a
+ * build partition to fit in cache; a pass writes to at most 2^BITS_PER_PASS
+ * partitions at once, few enough for the TLB and the caches to keep up. The
+ * matching partitions are then joined pairwise on worker threads, each with
+ * a small open-addressing table of 4-byte slots.
+ *
+ * The partitions can be joined a few at a time, as the caller asks for them,
+ * so that only the matches of those partitions are held at once, and a
+ * caller that stops early (e.g. under a LIMIT) skips joining the rest.
+ *
+ * RadixJoin never sees a tuple: the caller keeps them, and compares the keys
+ * of the tuples whose hashes are equal.
+ */
+class RadixJoin {
+ public:
+  /** Upper bound on the number of bits a partitioning pass splits on */
+  static constexpr uint32_t BITS_PER_PASS = 6;
+  /** The build entries a partition should hold at most, so that its table fits in a 256 KiB cache */
+  static constexpr std::size_t PARTITION_ENTRIES = 8192;
+
+  /** The hash of a tuple's join key, and the index of the tuple in its input */
+  struct Entry {
+    hash_t hash_;
+    uint32_t idx_;
+  };
+
+  /** Whether the left and right tuples with the given indexes have equal join keys; called from several threads */
+  using KeyEqual = std::function<bool(uint32_t, uint32_t)>;
+
+  /** The indexes of the joined left and right tuples */
+  using Matches = std::vector<std::pair<uint32_t, uint32_t>>;
+
+  /**
+   * @param parallelism The number of threads to partition and join on
+   * @param partition_entries The build entries a partition should hold at most
+   */
+  explicit RadixJoin(std::size_t parallelism, std::size_t partition_entries = PARTITION_ENTRIES)
+      : parallelism_(parallelism), partition_entries_(partition_entries) {}
+
+  /**
+   * Partition two inputs, to be joined by JoinPartitions().
+   * @param left The entries of the build side
+   * @param right The entries of the probe side
+   */
+  void Partition(std::vector<Entry> left, std::vector<Entry> right);
+
+  /** @return The number of partitions made by Partition() */
+  std::size_t GetPartitionCount() const { return left_bounds_.size() - 1; }
+
+  /**
+   * Join a range of the partitions made by Partition(), in parallel.
+   * @param first The first partition to join
+   * @param count The number of partitions to join
+   * @param equal Compares the join keys of a left and a right tuple whose hashes are equal
+   * @param[out] matches The matches, one vector per partition joined
+   */
+  void JoinPartitions(std::size_t first, std::size_t count, const KeyEqual &equal,
+                      std::vector<Matches> *matches) const;
+
+  /**
+   * Join two inputs all at once.
+   * @param left The entries of the build side
+   * @param right The entries of the probe side
+   * @param equal Compares the join keys of a left and a right tuple whose hashes are equal
+   * @return The matches, one vector per partition
+   */
+  std::vector<Matches> Join(std::vector<Entry> left, std::vector<Entry> right, const KeyEqual &equal);
+
+ private:
+  /** Run task(i) for every i below num_tasks on up to parallelism_ threads, rethrowing the first exception. */
+  void RunTasks(std::size_t num_tasks, const std::function<void(std::size_t)> &task) const;
+
+  /**
+   * Partition entries on the lowest bits of their hashes, with every thread
+   * scattering its own chunk into its own slice of each partition.
+   * @return The bounds of the partitions in entries, one more than there are partitions
+   */
+  std::vector<std::size_t> PartitionFirstPass(std::vector<Entry> *entries, uint32_t bits) const;
+
+  /** Split every partition of entries on bits [shift, shift + bits) of the hashes, a partition per task. */
+  void PartitionNextPass(std::vector<Entry> *entries, std::vector<std::size_t> *bounds, uint32_t shift,
+                         uint32_t bits) const;
+
+  /** Join the left and right entries of a partition, which agree on the lowest radix_bits bits of their hashes. */
+  void JoinPartition(const Entry *left, std::size_t left_size, const Entry *right, std::size_t right_size,
+                     uint32_t radix_bits, const KeyEqual &equal, Matches *matches) const;
+
+  std::size_t parallelism_;
+  std::size_t partition_entries_;
+
+  /** The partitioned inputs, the bounds of their partitions, and the number of bits they were partitioned on */
+  std::vector<Entry> left_;
+  std::vector<Entry> right_;
+  std::vector<std::size_t> left_bounds_{0, 0};
+  std::vector<std::size_t> right_bounds_{0, 0};
+  uint32_t radix_bits_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/plans/sort_plan.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * SortKeyEncoder turns the ORDER BY values of a row into a normalized binary
+ * key, such that comparing the keys of two rows byte by byte (as std::string
+ * does) orders the rows the way the ORDER BY does. Sorting on these keys
+ * saves a Value comparison, with its type dispatch, per ORDER BY expression
+ * of every comparison.
+ *
+ * The keys use the index key encoding of KeyEncoder, with the bytes of the
+ * descending columns inverted.
+ */
+class SortKeyEncoder {
+ public:
+  /** @param order_bys The ORDER BY expressions, with their directions */
+  explicit SortKeyEncoder(const std::vector<std::pair<OrderByType, const AbstractExpression *>> &order_bys);
+
+  /**
+   * @param values The values of the ORDER BY expressions for a row, in order
+   * @return The sort key of the row
+   */
+  std::string Encode(const std::vector<Value> &values) const;
+
+ private:
+  /** Lays out the ORDER BY values as a tuple for KeyEncoder */
+  Schema key_schema_;
+  /** Whether each ORDER BY expression sorts in descending order */
+  std::vector<bool> descending_;
+};
+
+}  // namespace bustub
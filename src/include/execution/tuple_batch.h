@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * TupleBatch is the unit of work of AbstractExecutor::NextBatch: up to
+ * TUPLE_BATCH_SIZE rows of one schema, stored column by column, plus a
+ * selection vector listing the rows that are still part of the result.
+ *
+ * Filters drop rows by narrowing the selection instead of copying the
+ * surviving ones, so a row index always refers to the same row until the
+ * batch is reset. Everything that walks a batch goes through the selection.
+ */
+class TupleBatch {
+ public:
+  TupleBatch() = default;
+
+  /**
+   * Empty the batch and lay it out for rows of the given schema, which is
+   * nullptr for executors that produce no output, such as inserts.
+   */
+  void Reset(const Schema *schema);
+
+  /** @return The schema of the rows in this batch */
+  const Schema *GetSchema() const { return schema_; }
+
+  /** @return The number of rows stored, selected or not */
+  uint32_t GetRowCount() const { return static_cast<uint32_t>(rids_.size()); }
+
+  /** @return `true` if no more rows may be appended */
+  bool IsFull() const { return GetRowCount() >= static_cast<uint32_t>(TUPLE_BATCH_SIZE); }
+
+  /** @return The number of selected rows */
+  uint32_t Size() const { return static_cast<uint32_t>(selection_.size()); }
+
+  /** @return `true` if no row is selected */
+  bool IsEmpty() const { return selection_.empty(); }
+
+  /** @return The indexes of the selected rows, in output order */
+  const std::vector<uint32_t> &GetSelection() const { return selection_; }
+
+  /** Replace the selection; selection must only hold indexes of stored rows. */
+  void Select(std::vector<uint32_t> &&selection) { selection_ = std::move(selection); }
+
+  /** Keep only the first size selected rows. */
+  void Truncate(uint32_t size);
+
+  /** @return The values of the col_idx'th column, indexed by row */
+  const std::vector<Value> &GetColumn(uint32_t col_idx) const { return columns_[col_idx]; }
+
+  /** @return The value of the col_idx'th column of the given row */
+  const Value &GetValue(uint32_t col_idx, uint32_t row) const { return columns_[col_idx][row]; }
+
+  /** @return The RID of the given row */
+  const RID &GetRid(uint32_t row) const { return rids_[row]; }
+
+  /** Append a selected row holding the values of tuple, which must have this batch's schema. */
+  void AppendTuple(const Tuple &tuple, const RID &rid);
+
+  /** Append a selected row holding values, one per column. */
+  void AppendRow(const std::vector<Value> &values, const RID &rid);
+
+  /**
+   * Replace the content of the batch with whole columns, every one as long
+   * as rids, and select all of their rows.
+   */
+  void SetColumns(std::vector<std::vector<Value>> &&columns, std::vector<RID> &&rids);
+
+  /** @return The given row as a tuple */
+  Tuple GetTuple(uint32_t row) const;
+
+ private:
+  const Schema *schema_{nullptr};
+  std::vector<std::vector<Value>> columns_;
+  std::vector<RID> rids_;
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
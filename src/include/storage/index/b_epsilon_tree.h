@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree.h
+//
+// Identification: src/include/storage/index/b_epsilon_tree.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <climits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rwlatch.h"
+#include "concurrency/transaction.h"
+#include "storage/page/b_epsilon_tree_internal_page.h"
+#include "storage/page/b_plus_tree_leaf_page.h"
+
+namespace bustub {
+
+#define B_EPSILON_TREE_TYPE BEpsilonTree<KeyType, ValueType, KeyComparator>
+
+/**
+ * Write-optimized B-epsilon tree mapping unique keys to values.
+ *
+ * Leaves are BPlusTreeLeafPages. Internal pages (BEpsilonTreeInternalPage)
+ * keep only a few children and spend the rest of the page on a buffer of
+ * pending inserts and deletes. Insert and Remove merely add a message to the
+ * root's buffer. Once a buffer fills up, the messages bound for the child
+ * that has the most of them move down one level as a batch, so a leaf is
+ * rewritten once for many updates instead of once per update. A batch that
+ * overfills a leaf or an internal page splits it into as many pages as
+ * needed; leaves emptied by deletes are dropped, but pages are never merged.
+ *
+ * Lookups descend as usual and the first pending message for their key on
+ * the way down, which is the newest one, decides the answer. Range lookups
+ * apply the messages of every page in the range on top of what lies below it.
+ *
+ * Inserting an existing key replaces its value. Concurrency is kept simple,
+ * as in VarlenBPlusTree: one tree-wide latch, held in read mode by lookups
+ * and in write mode by Insert and Remove.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BEpsilonTree {
+  using InternalPage = BEpsilonTreeInternalPage<KeyType, ValueType, KeyComparator>;
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  using Message = BEpsilonMessage<KeyType, ValueType>;
+  using Pivot = std::pair<KeyType, page_id_t>;
+
+ public:
+  explicit BEpsilonTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                        int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = B_EPSILON_FANOUT,
+                        int buffer_max_size = INT_MAX, page_id_t header_page_id = HEADER_PAGE_ID);
+
+  // Returns true if this tree has no pages; once it has internal pages, they stay even if every key is removed.
+  bool IsEmpty() const;
+
+  // Insert a key-value pair, replacing the value of an existing key.
+  void Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Remove a key and its value from this tree.
+  void Remove(const KeyType &key, Transaction *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr);
+
+  // append the entries with keys in [low, high] to result, in key order
+  void GetRange(const KeyType &low, const KeyType &high, std::vector<MappingType> *result,
+                Transaction *transaction = nullptr);
+
+ private:
+  // add message to the root's buffer, flushing it if it fills up
+  void Put(const Message &message);
+
+  // apply messages, sorted by key, to the subtree at page_id; returns the pivots of the new right siblings of the
+  // page if it had to be split and sets emptied if it is a leaf that has no entries left
+  std::vector<Pivot> PushDown(page_id_t page_id, const std::vector<Message> &messages, bool *emptied);
+
+  // spread entries over leaf and as many new leaves as needed, returning the pivots of the new ones
+  std::vector<Pivot> WriteLeaves(LeafPage *leaf, const std::vector<MappingType> &entries);
+
+  // spread pivots and messages over node and as many new internal pages as needed, as WriteLeaves
+  std::vector<Pivot> WriteInternals(InternalPage *node, const std::vector<Pivot> &pivots,
+                                    const std::vector<Message> &messages);
+
+  // append what the subtree at page_id holds in [low, high] to result, in key order
+  void Collect(page_id_t page_id, const KeyType &low, const KeyType &high, std::vector<MappingType> *result);
+
+  // entries with messages applied; both sorted by key
+  std::vector<MappingType> ApplyMessages(const std::vector<MappingType> &entries, const Message *first,
+                                         const Message *last) const;
+
+  // older and newer messages merged by key, the newer one winning for the same key
+  std::vector<Message> MergeMessages(const std::vector<Message> &older, const std::vector<Message> &newer) const;
+
+  Page *FetchPage(page_id_t page_id);
+
+  Page *NewPage(page_id_t *page_id);
+
+  void UpdateRootPageId(int insert_record = 0);
+
+  // member variable
+  std::string index_name_;
+  page_id_t root_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+  int leaf_max_size_;
+  int internal_max_size_;
+  int buffer_max_size_;
+  // the header page that records root_page_id_ under index_name_
+  page_id_t header_page_id_;
+  // guards the whole tree
+  ReaderWriterLatch latch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree_index.h
+//
+// Identification: src/include/storage/index/b_epsilon_tree_index.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/index/b_epsilon_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define B_EPSILON_TREE_INDEX_TYPE BEpsilonTreeIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * Write-optimized secondary index over a BEpsilonTree. Inserts and deletes
+ * are buffered in the internal pages and reach the leaves in batches.
+ *
+ * Like a non-unique BPlusTreeIndex, it appends the RID of every entry to its
+ * key, so duplicate keys are allowed and a delete names exactly the entry it
+ * removes. KeyType has to be longer than RID_SUFFIX_SIZE.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BEpsilonTreeIndex : public Index {
+ public:
+  BEpsilonTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                    page_id_t header_page_id = HEADER_PAGE_ID);
+
+  void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+  // RIDs of the entries with keys in [low_key, high_key], in key order
+  void ScanRange(const Tuple &low_key, const Tuple &high_key, std::vector<RID> *result, Transaction *transaction);
+
+ protected:
+  // the tree key of an entry: the key followed by rid
+  void MakeKey(const Tuple &key, const RID &rid, KeyType *index_key) const;
+
+  // comparator for key
+  KeyComparator comparator_;
+  // container
+  BEpsilonTree<KeyType, ValueType, KeyComparator> container_;
+};
+
+}  // namespace bustub
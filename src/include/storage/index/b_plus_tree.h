@@ -10,10 +10,13 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
 
+#include "common/rwlatch.h"
 #include "concurrency/transaction.h"
 #include "storage/index/index_iterator.h"
 #include "storage/page/b_plus_tree_internal_page.h"
@@ -23,15 +26,41 @@ namespace bustub {
 
 #define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
 
+/**
+ * How a B+ tree synchronizes concurrent operations, chosen per tree.
+ * LATCH_CRABBING: latch coupling from the root down, with merges on underflow.
+ * B_LINK: Lehman-Yao B-link tree; lookups never latch and pages are never merged.
+ */
+enum class BPlusTreeProtocol { LATCH_CRABBING, B_LINK };
+
+/** The share of every page that BulkLoad fills unless told otherwise; the rest is left for later inserts. */
+static constexpr double BULK_LOAD_FILL_FACTOR = 0.9;
+
 /**
  * Main class providing the API for the Interactive B+ Tree.
  *
  * Implementation of simple b+ tree data structure where internal pages direct
  * the search and leaf pages contain actual data.
- * (1) We only support unique key
+ * (1) We only support unique key; non-unique indexes append the RID to the key (see BPlusTreeIndex)
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ *
+ * Concurrency follows latch crabbing. Every operation first descends optimistically with read
+ * latches, releasing each parent once the child is latched, and takes a write latch only on the
+ * leaf. Insert and Remove finish there when the leaf stays safe, i.e. it will neither split nor
+ * underflow. Otherwise they restart pessimistically: the descent write latches every page and
+ * keeps the unsafe ancestors in the transaction's page set, together with a nullptr entry that
+ * stands for root_latch_, until the structure modification is done. Pages emptied by a merge
+ * are collected in the deleted page set and freed after every latch has been released.
+ *
+ * The B_LINK protocol relies on the right links and high keys kept on every page. Lookups
+ * take no latch at all: they read each page optimistically against its version and move
+ * right whenever the key lies beyond a page's high key, which is how they catch up with a
+ * concurrent split. Writers descend the same way, write latch only the leaf (moving right
+ * under the latch if needed) and, after a split, latch the parent before releasing the
+ * child. Latches are thus taken bottom-up and left to right. Removal only deletes from the
+ * leaf: pages are never merged or freed, so underfull pages stay in place.
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTree {
@@ -40,7 +69,9 @@ class BPlusTree {
 
  public:
   explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE);
+                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE,
+                     BPlusTreeProtocol protocol = BPlusTreeProtocol::LATCH_CRABBING,
+                     page_id_t header_page_id = HEADER_PAGE_ID);
 
   // Returns true if this B+ tree has no keys and values.
   bool IsEmpty() const;
@@ -54,9 +85,19 @@ class BPlusTree {
   // return the value associated with a given key
   bool GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr);
 
+  // Build this B+ tree bottom-up from a batch of key-value pairs, which need not be sorted.
+  bool BulkLoad(const std::vector<MappingType> &items, double fill_factor = BULK_LOAD_FILL_FACTOR,
+                Transaction *transaction = nullptr);
+
   // index iterator
   INDEXITERATOR_TYPE Begin();
   INDEXITERATOR_TYPE Begin(const KeyType &key);
+  // the pairs with keys in [low, high], where either bound may be left open, in ascending or (if reverse)
+  // descending order, fetching up to read_ahead leaves ahead of the scan in the background
+  INDEXITERATOR_TYPE Begin(const std::optional<KeyType> &low, const std::optional<KeyType> &high,
+                           bool reverse = false, int read_ahead = 0);
+  // all pairs in descending order
+  INDEXITERATOR_TYPE RBegin();
   INDEXITERATOR_TYPE End();
 
   void Print(BufferPoolManager *bpm) {
@@ -76,10 +117,78 @@ class BPlusTree {
 
   // read data from file and remove one by one
   void RemoveFromFile(const std::string &file_name, Transaction *transaction = nullptr);
-  // expose for test purpose
+  // expose for test purpose; the returned page is pinned but not latched
   Page *FindLeafPage(const KeyType &key, bool leftMost = false);
 
  private:
+  enum class Operation { READ, INSERT, DELETE };
+
+  // optimistic descent: read latches on the way down, a write latch on the leaf unless op is READ.
+  // Returns nullptr if the tree is empty.
+  Page *FindLeafPageOptimistic(const KeyType &key, bool left_most, Operation op, bool right_most = false);
+
+  // pessimistic descent: root_latch_ must be write locked and recorded in the page set.
+  Page *FindLeafPagePessimistic(const KeyType &key, Operation op, Transaction *transaction);
+
+  // the leaf a scan starts from, pinned and read latched
+  Page *FindLeafPageRead(const KeyType &key, bool left_most, bool right_most = false);
+
+  // whether op on node can not propagate to its parent
+  bool IsSafe(BPlusTreePage *node, Operation op) const;
+
+  // unlatch and unpin everything in the page set, then free the pages in the deleted page set
+  void ReleaseLatches(Transaction *transaction, bool is_dirty);
+
+  Page *FetchPage(page_id_t page_id);
+
+  // point the back link of a leaf at its new left neighbor
+  void SetPrevLink(page_id_t page_id, page_id_t prev_page_id);
+
+  /* B-link protocol */
+  bool GetValueBLink(const KeyType &key, std::vector<ValueType> *result);
+
+  bool InsertBLink(const KeyType &key, const ValueType &value);
+
+  void InsertIntoParentBLink(Page *old_page, const KeyType &key, Page *new_page);
+
+  void RemoveBLink(const KeyType &key);
+
+  // latch-free descent to the leaf covering key; the leaf is returned pinned but not latched
+  Page *FindLeafPageBLink(const KeyType &key, bool left_most, bool right_most = false);
+
+  // descend to the leaf covering key and write latch it, moving right past concurrent splits
+  Page *LatchLeafPageBLink(const KeyType &key);
+
+  // the right sibling of node if key lies beyond node's high key, INVALID_PAGE_ID otherwise
+  page_id_t MoveRight(BPlusTreePage *node, const KeyType &key) const;
+
+  // the right sibling of node, INVALID_PAGE_ID for the rightmost page of its level
+  page_id_t RightSibling(BPlusTreePage *node) const;
+
+  /* bulk loading */
+  // one level of a tree under construction: its final shape and the page currently being filled
+  struct BulkLevel {
+    // the number of entries of the page_index-th page, spreading num_entries evenly over num_pages
+    int PageSize() const { return num_entries / num_pages + (page_index < num_entries % num_pages ? 1 : 0); }
+
+    int num_pages;
+    int num_entries;
+    int page_index{0};
+    Page *page{nullptr};
+    // the smallest key stored below page
+    KeyType low_key{};
+  };
+
+  // lay out a new tree over sorted, distinct pairs and return its root page id
+  page_id_t BulkBuild(const std::vector<MappingType> &items, double fill_factor);
+
+  // append a leaf item (level 0) or a child page (above) to the page being filled at level
+  void BulkAppend(std::vector<BulkLevel> *levels, size_t level, const KeyType &key, const MappingType *item,
+                  page_id_t child_page_id);
+
+  // link the page being filled at level into its parent and write it out
+  void BulkClosePage(std::vector<BulkLevel> *levels, size_t level);
+
   void StartNewTree(const KeyType &key, const ValueType &value);
 
   bool InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
@@ -88,7 +197,7 @@ class BPlusTree {
                         Transaction *transaction = nullptr);
 
   template <typename N>
-  N *Split(N *node);
+  N *Split(N *node, Page **new_page = nullptr);
 
   template <typename N>
   bool CoalesceOrRedistribute(N *node, Transaction *transaction = nullptr);
@@ -111,11 +220,16 @@ class BPlusTree {
 
   // member variable
   std::string index_name_;
-  page_id_t root_page_id_;
+  std::atomic<page_id_t> root_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
+  BPlusTreeProtocol protocol_;
+  // the header page that records root_page_id_ under index_name_
+  page_id_t header_page_id_;
+  // protects changes to root_page_id_
+  ReaderWriterLatch root_latch_;
 };
 
 }  // namespace bustub
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "storage/index/b_plus_tree.h"
@@ -23,10 +24,20 @@ namespace bustub {
 
 #define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
 
+/**
+ * An index over a BPlusTree.
+ *
+ * A non-unique index appends the RID of every entry to its key (see GenericKey), so the tree
+ * still holds unique keys, equal keys sit next to each other in RID order, and ScanKey finds
+ * all of them in a single walk over the leaves. The key columns then only get the first
+ * sizeof(KeyType) - RID_SUFFIX_SIZE bytes.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                 BPlusTreeProtocol protocol = BPlusTreeProtocol::LATCH_CRABBING,
+                 page_id_t header_page_id = HEADER_PAGE_ID, bool unique = true);
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
@@ -34,13 +45,24 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  void BulkInsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) override;
+
   INDEXITERATOR_TYPE GetBeginIterator();
 
   INDEXITERATOR_TYPE GetBeginIterator(const KeyType &key);
 
+  // entries with keys in [low_key, high_key], nullptr for an open bound, in ascending or (if reverse) descending order
+  INDEXITERATOR_TYPE GetRangeIterator(const Tuple *low_key, const Tuple *high_key, bool reverse = false,
+                                      int read_ahead = 0);
+
   INDEXITERATOR_TYPE GetEndIterator();
 
  protected:
+  // the tree key of an entry, with rid appended unless the index is unique
+  void MakeKey(const Tuple &key, const RID &rid, KeyType *index_key) const;
+
+  // whether every key appears at most once
+  bool unique_;
   // comparator for key
   KeyComparator comparator_;
   // container
@@ -15,6 +15,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "container/hash/extendible_hash_table.h"
@@ -39,6 +40,15 @@ class ExtendibleHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                Transaction *transaction) override;
+
+  void BulkInsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) override;
+
+  HASH_TABLE_ITERATOR_TYPE GetBeginIterator();
+
+  std::vector<HASH_TABLE_ITERATOR_TYPE> GetPartitionIterators(uint32_t num_partitions);
+
  protected:
   // comparator for key
   KeyComparator comparator_;
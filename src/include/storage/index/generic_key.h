@@ -14,53 +14,76 @@
 
 #include <cstring>
 
+#include "common/rid.h"
+#include "storage/index/key_encoder.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
 namespace bustub {
 
+/** The bytes a RID takes at the end of a non-unique GenericKey */
+static constexpr size_t RID_SUFFIX_SIZE = sizeof(page_id_t) + sizeof(uint32_t);
+/** RIDs that bound every suffix: invalid page ids sort after all valid ones */
+static const RID RID_SUFFIX_MIN{0, 0};
+static const RID RID_SUFFIX_MAX{INVALID_PAGE_ID, UINT32_MAX};
+
 /**
  * Generic key is used for indexing with opaque data.
  *
  * This key type uses an fixed length array to hold data for indexing
  * purposes, the actual size of which is specified and instantiated
  * with a template argument.
+ *
+ * The key columns are stored in the order-preserving encoding of KeyEncoder,
+ * so that two keys of the same schema compare with a single memcmp. Whatever
+ * does not fit into KeySize is cut off, so keys that only differ past it
+ * compare equal.
+ *
+ * Non-unique indexes keep the last RID_SUFFIX_SIZE bytes for the RID of the
+ * entry, which makes every key unique and orders equal keys by RID.
  */
 template <size_t KeySize>
 class GenericKey {
  public:
-  inline void SetFromKey(const Tuple &tuple) {
+  inline void SetFromKey(const Tuple &tuple, const Schema *key_schema) {
     // intialize to 0
     memset(data_, 0, KeySize);
-    memcpy(data_, tuple.GetData(), tuple.GetLength());
+    KeyEncoder(data_, KeySize).PutTuple(tuple, key_schema);
+  }
+
+  /**
+   * Like SetFromKey, but with rid appended big-endian as a tiebreaker.
+   * RID_SUFFIX_MIN and RID_SUFFIX_MAX stand for the first and last RID of a key.
+   */
+  inline void SetFromKey(const Tuple &tuple, const Schema *key_schema, const RID &rid) {
+    static_assert(KeySize > RID_SUFFIX_SIZE, "no room for a RID suffix");
+    memset(data_, 0, KeySize);
+    KeyEncoder(data_, KeySize - RID_SUFFIX_SIZE).PutTuple(tuple, key_schema);
+    uint64_t bits = static_cast<uint64_t>(static_cast<uint32_t>(rid.GetPageId())) << 32 | rid.GetSlotNum();
+    for (size_t i = 0; i < RID_SUFFIX_SIZE; i++) {
+      data_[KeySize - 1 - i] = static_cast<char>(bits >> (i * 8));
+    }
   }
 
   // NOTE: for test purpose only
+  // encodes key like a single BIGINT column
   inline void SetFromInteger(int64_t key) {
     memset(data_, 0, KeySize);
-    memcpy(data_, &key, sizeof(int64_t));
+    KeyEncoder(data_, KeySize).PutBigInt(key);
   }
 
-  inline Value ToValue(Schema *schema, uint32_t column_idx) const {
-    const char *data_ptr;
-    const auto &col = schema->GetColumn(column_idx);
-    const TypeId column_type = col.GetType();
-    const bool is_inlined = col.IsInlined();
-    if (is_inlined) {
-      data_ptr = (data_ + col.GetOffset());
-    } else {
-      int32_t offset = *reinterpret_cast<int32_t *>(const_cast<char *>(data_ + col.GetOffset()));
-      data_ptr = (data_ + offset);
+  // NOTE: for test purpose only
+  // decode the first 8 bytes as a BIGINT column
+  inline int64_t ToString() const {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(bits) && i < KeySize; i++) {
+      bits = bits << 8 | static_cast<uint8_t>(data_[i]);
     }
-    return Value::DeserializeFrom(data_ptr, column_type);
+    return static_cast<int64_t>(bits ^ (uint64_t{1} << 63));
   }
 
   // NOTE: for test purpose only
-  // interpret the first 8 bytes as int64_t from data vector
-  inline int64_t ToString() const { return *reinterpret_cast<int64_t *>(const_cast<char *>(data_)); }
-
-  // NOTE: for test purpose only
-  // interpret the first 8 bytes as int64_t from data vector
+  // decode the first 8 bytes as a BIGINT column
   friend std::ostream &operator<<(std::ostream &os, const GenericKey &key) {
     os << key.ToString();
     return os;
@@ -72,35 +95,20 @@ class GenericKey {
 
 /**
  * Function object returns true if lhs < rhs, used for trees
+ *
+ * Keys are normalized by GenericKey::SetFromKey, so comparing them does not
+ * need the key schema.
  */
 template <size_t KeySize>
 class GenericComparator {
  public:
   inline int operator()(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const {
-    uint32_t column_count = key_schema_->GetColumnCount();
-
-    for (uint32_t i = 0; i < column_count; i++) {
-      Value lhs_value = (lhs.ToValue(key_schema_, i));
-      Value rhs_value = (rhs.ToValue(key_schema_, i));
-
-      if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
-        return -1;
-      }
-      if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
-        return 1;
-      }
-    }
-    // equals
-    return 0;
+    int cmp = memcmp(lhs.data_, rhs.data_, KeySize);
+    return (cmp > 0) - (cmp < 0);
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
-
   // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
-
- private:
-  Schema *key_schema_;
+  explicit GenericComparator(Schema * /* key_schema */) {}
 };
 
 }  // namespace bustub
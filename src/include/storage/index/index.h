@@ -175,6 +175,40 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Search the index for a batch of keys. Indexes that can share work between the keys of
+   * a batch (e.g. fetch each page once) should override this; by default every key goes
+   * through ScanKey().
+   * @param keys The index keys
+   * @param results Replaced with one collection of RIDs per key, in the order of keys
+   * @param transaction The transaction context
+   */
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                        Transaction *transaction) {
+    results->clear();
+    results->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*results)[i], transaction);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Modification
+  ///////////////////////////////////////////////////////////////////
+
+  /**
+   * Insert a batch of entries into the index, e.g. when building the index over an existing table.
+   * Indexes that can build their structure in one pass should override this; by default every
+   * entry goes through InsertEntry().
+   * @param entries The (index key, RID) pairs to insert
+   * @param transaction The transaction context
+   */
+  virtual void BulkInsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) {
+    for (const auto &entry : entries) {
+      InsertEntry(entry.first, entry.second, transaction);
+    }
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
@@ -13,31 +13,94 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <future>  // NOLINT
+#include <optional>
+#include <vector>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
 
 namespace bustub {
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
 
+/**
+ * Iterator over the leaf level of a B+ tree, in ascending or descending key order.
+ *
+ * The iterator copies the pairs of one leaf at a time under the leaf's read latch and then
+ * releases the page, so a scan never holds a latch or a pin between calls and cannot deadlock
+ * with writers that latch siblings. Leaves are followed through their next page ids, or their
+ * prev page ids in reverse; entries moved between leaves by a concurrent split or merge may be
+ * skipped or seen twice.
+ *
+ * A scan may be bounded by a low and a high key (both inclusive). Leaves beyond the bound in
+ * the direction of the scan are never read. With read ahead, a background task fetches the
+ * next leaves of the scan into the buffer pool while the current one is consumed, staying
+ * up to read_ahead leaves ahead of it.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
  public:
-  // you may define your own constructor based on your member variables
+  // the end iterator
   IndexIterator();
+  /**
+   * @param buffer_pool_manager buffer pool manager of the tree
+   * @param leaf_page the leaf to start from, pinned and read latched by the caller; the iterator releases both
+   * @param comparator comparator of the tree, which must outlive the iterator
+   * @param low if given, pairs with smaller keys are skipped
+   * @param high if given, pairs with greater keys are skipped
+   * @param reverse whether to visit the pairs in descending order
+   * @param read_ahead the number of leaves to keep fetching ahead of the scan, 0 for none
+   */
+  IndexIterator(BufferPoolManager *buffer_pool_manager, Page *leaf_page, const KeyComparator *comparator,
+                std::optional<KeyType> low, std::optional<KeyType> high, bool reverse = false, int read_ahead = 0);
+  IndexIterator(IndexIterator &&other) noexcept = default;
+  IndexIterator &operator=(IndexIterator &&other) noexcept = default;
   ~IndexIterator();
 
   bool IsEnd();
 
   const MappingType &operator*();
 
+  // moves on to the next pair in the direction of the scan
   IndexIterator &operator++();
 
-  bool operator==(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator==(const IndexIterator &itr) const { return page_id_ == itr.page_id_ && index_ == itr.index_; }
 
-  bool operator!=(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator!=(const IndexIterator &itr) const { return !(*this == itr); }
 
  private:
-  // add your own private member variables here
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+
+  // copy the pairs of a latched leaf within the bounds into items_, in the order of the scan, and release it
+  void CopyLeaf(Page *leaf_page);
+  // move on to the first pair of the next non-empty leaf, or to the end
+  void LoadNextLeaf();
+  // fetch and read latch a leaf
+  Page *FetchLeaf(page_id_t page_id);
+  // the leaf before the one the scan just left, read latched
+  Page *FetchPrevLeaf();
+  // hand the read ahead task its next leaves, if it has finished and the scan is catching up
+  void ReadAhead();
+
+  BufferPoolManager *buffer_pool_manager_{nullptr};
+  const KeyComparator *comparator_{nullptr};
+  std::optional<KeyType> low_;
+  std::optional<KeyType> high_;
+  bool reverse_{false};
+  // leaf the current pairs were copied from, INVALID_PAGE_ID at the end
+  page_id_t page_id_{INVALID_PAGE_ID};
+  // the leaf after it in the direction of the scan, INVALID_PAGE_ID past the last one or the bound
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  std::vector<MappingType> items_;
+  size_t index_{0};
+
+  int read_ahead_{0};
+  // leaves fetched (or being fetched) ahead of the current one
+  int leaves_ahead_{0};
+  // where the read ahead continues
+  page_id_t read_ahead_page_id_{INVALID_PAGE_ID};
+  // returns the leaf after the ones it fetched
+  std::future<page_id_t> read_ahead_task_;
 };
 
 }  // namespace bustub
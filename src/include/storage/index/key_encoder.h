@@ -0,0 +1,165 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder.h
+//
+// Identification: src/include/storage/index/key_encoder.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+
+#include "storage/table/tuple.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+/**
+ * Writes index keys in a normalized, order-preserving encoding, so that two
+ * keys of the same schema compare with a single memcmp:
+ * - integer types (and booleans) big-endian with the sign bit flipped,
+ * - decimals big-endian with the sign bit flipped if positive and every bit
+ *   flipped if negative,
+ * - timestamps big-endian, shifted up by one to make room for NULL,
+ * - varchars as a 0x01 marker followed by their bytes, each 0x00 escaped as
+ *   0x00 0xFF, and a 0x00 0x00 terminator.
+ * NULLs sort first: integers and decimals store NULL as the lowest value of
+ * their type, timestamps as 0 and varchars as a single 0x00 marker.
+ *
+ * Bytes past the end of the buffer are dropped, but still counted by
+ * GetLength(), so callers can tell whether the key was cut off.
+ */
+class KeyEncoder {
+ public:
+  KeyEncoder(char *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+  /** Appends every column of a tuple laid out by key_schema. */
+  inline void PutTuple(const Tuple &tuple, const Schema *key_schema) {
+    for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+      PutColumn(tuple, key_schema->GetColumn(i));
+    }
+  }
+
+  /** Appends one column of a tuple. */
+  inline void PutColumn(const Tuple &tuple, const Column &col) {
+    const char *data_ptr = tuple.GetData() + col.GetOffset();
+    switch (col.GetType()) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        PutSigned<int8_t>(data_ptr);
+        break;
+      case TypeId::SMALLINT:
+        PutSigned<int16_t>(data_ptr);
+        break;
+      case TypeId::INTEGER:
+        PutSigned<int32_t>(data_ptr);
+        break;
+      case TypeId::BIGINT:
+        PutSigned<int64_t>(data_ptr);
+        break;
+      case TypeId::DECIMAL:
+        PutDecimal(data_ptr);
+        break;
+      case TypeId::TIMESTAMP:
+        PutTimestamp(data_ptr);
+        break;
+      case TypeId::VARCHAR:
+        PutVarchar(tuple.GetData() + *reinterpret_cast<const uint32_t *>(data_ptr));
+        break;
+      default:
+        break;
+    }
+  }
+
+  /**
+   * Flips every bit written after the first `from` bytes, so that the columns
+   * appended since then sort in descending order. This is sound because the
+   * encoding of a column is never a proper prefix of another one's.
+   */
+  inline void InvertFrom(size_t from) {
+    for (size_t i = from; i < pos_ && i < capacity_; i++) {
+      buffer_[i] = static_cast<char>(~buffer_[i]);
+    }
+  }
+
+  /** Appends a BIGINT column. */
+  inline void PutBigInt(int64_t value) { PutSigned<int64_t>(reinterpret_cast<const char *>(&value)); }
+
+  /** @return the length of the encoding so far, including bytes that did not fit into the buffer */
+  inline size_t GetLength() const { return pos_; }
+
+ private:
+  // append one byte, dropping it if the buffer is full
+  inline void PutByte(uint8_t byte) {
+    if (pos_ < capacity_) {
+      buffer_[pos_] = static_cast<char>(byte);
+    }
+    pos_++;
+  }
+
+  // append the low size bytes of bits, most significant first
+  inline void PutBigEndian(uint64_t bits, size_t size) {
+    for (size_t i = size; i-- > 0;) {
+      PutByte(static_cast<uint8_t>(bits >> (i * 8)));
+    }
+  }
+
+  template <typename T>
+  inline void PutSigned(const char *data_ptr) {
+    T value;
+    memcpy(&value, data_ptr, sizeof(T));
+    // flipping the sign bit orders negative numbers before positive ones
+    auto bits = static_cast<uint64_t>(static_cast<int64_t>(value)) ^ (uint64_t{1} << (sizeof(T) * 8 - 1));
+    PutBigEndian(bits, sizeof(T));
+  }
+
+  inline void PutDecimal(const char *data_ptr) {
+    double value;
+    memcpy(&value, data_ptr, sizeof(value));
+    // -0.0 and 0.0 are equal
+    if (value == 0) {
+      value = 0;
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = (bits >> 63) != 0 ? ~bits : bits | uint64_t{1} << 63;
+    PutBigEndian(bits, sizeof(bits));
+  }
+
+  inline void PutTimestamp(const char *data_ptr) {
+    uint64_t value;
+    memcpy(&value, data_ptr, sizeof(value));
+    PutBigEndian(value == BUSTUB_TIMESTAMP_NULL ? 0 : value + 1, sizeof(value));
+  }
+
+  inline void PutVarchar(const char *data_ptr) {
+    uint32_t len;
+    memcpy(&len, data_ptr, sizeof(len));
+    if (len == BUSTUB_VALUE_NULL) {
+      PutByte(0);
+      return;
+    }
+    PutByte(1);
+    // the stored length counts the terminating '\0', which comparisons ignore
+    for (uint32_t i = 0; i + 1 < len; i++) {
+      auto byte = static_cast<uint8_t>(data_ptr[sizeof(uint32_t) + i]);
+      PutByte(byte);
+      if (byte == 0) {
+        PutByte(0xFF);
+      }
+    }
+    PutByte(0);
+    PutByte(0);
+  }
+
+  char *buffer_;
+  size_t capacity_;
+  size_t pos_{0};
+};
+
+}  // namespace bustub
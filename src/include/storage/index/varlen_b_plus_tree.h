@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree.h
+//
+// Identification: src/include/storage/index/varlen_b_plus_tree.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rid.h"
+#include "common/rwlatch.h"
+#include "concurrency/transaction.h"
+#include "storage/index/varlen_b_plus_tree_iterator.h"
+#include "storage/page/b_plus_tree_varlen_page.h"
+
+namespace bustub {
+
+/**
+ * B+ tree over variable-length byte-string keys, compared with memcmp, mapping
+ * each key to one RID. Keys are typically produced by KeyEncoder.
+ *
+ * Pages are BPlusTreeVarlenPages: slotted pages that store every key without
+ * the prefix all keys of the page share, so a page holds as many keys as
+ * their distinguishing bytes allow instead of a fixed number of fixed-size
+ * keys. Leaf splits cut at the middle byte and push up only the shortest
+ * separator that tells the two halves apart, which keeps internal pages short
+ * and the fanout high. Removal merges a page that falls below a quarter full
+ * into a sibling when their entries fit into one page.
+ *
+ * Concurrency is kept simple, as in the hash tables: one tree-wide latch,
+ * held in read mode by lookups and iterators and in write mode by Insert and
+ * Remove. Descents remember their path, so pages need no parent pointers.
+ */
+class VarlenBPlusTree {
+  using InternalPage = BPlusTreeVarlenPage<page_id_t>;
+  using LeafPage = BPlusTreeVarlenPage<RID>;
+
+ public:
+  explicit VarlenBPlusTree(std::string name, BufferPoolManager *buffer_pool_manager,
+                           page_id_t header_page_id = HEADER_PAGE_ID);
+
+  // Returns true if this B+ tree has no keys and values.
+  bool IsEmpty() const;
+
+  // Insert a key-value pair; false if the key exists or is longer than VARLEN_KEY_MAX_SIZE.
+  bool Insert(std::string_view key, const RID &value, Transaction *transaction = nullptr);
+
+  // Remove a key and its value from this B+ tree.
+  void Remove(std::string_view key, Transaction *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(std::string_view key, std::vector<RID> *result, Transaction *transaction = nullptr);
+
+  // index iterator, starting at the first key or at the first key not less than key
+  VarlenBPlusTreeIterator Begin();
+  VarlenBPlusTreeIterator Begin(std::string_view key);
+
+ private:
+  friend class VarlenBPlusTreeIterator;
+
+  // the pages from the root down to a leaf, pinned, with the child index taken on every internal page
+  struct Path {
+    std::vector<Page *> pages;
+    std::vector<int> child_indexes;
+  };
+
+  // descend to the leaf covering key; the tree must not be empty
+  void FindLeaf(std::string_view key, Path *path);
+
+  void UnpinPath(const Path &path, bool is_dirty);
+
+  // insert key into the full leaf at the end of path, splitting it
+  void SplitLeaf(Path *path, int index, std::string_view key, const RID &value);
+
+  // link a new right sibling of the page at level into its parent, splitting upwards as needed
+  void InsertIntoParent(Path *path, size_t level, const std::string &key, page_id_t right_page_id);
+
+  // merge underfull pages upwards from level, collecting the pages to free in deleted_page_ids
+  void CoalesceUp(Path *path, size_t level, std::vector<page_id_t> *deleted_page_ids);
+
+  // merge the underfull page at level with a sibling if both fit into one page; true if they were merged
+  template <typename N>
+  bool Coalesce(Path *path, size_t level, std::vector<page_id_t> *deleted_page_ids);
+
+  // copy the leaf items from key on (or, unless inclusive, after key) until a non-empty leaf is found
+  void LoadItems(std::string_view key, bool inclusive, std::vector<VarlenMappingType> *items);
+
+  // a byte-balanced split point of entries that leaves both halves non-empty
+  template <typename ValueType>
+  static size_t SplitPoint(const std::vector<std::pair<std::string, ValueType>> &entries);
+
+  Page *FetchPage(page_id_t page_id);
+
+  Page *NewPage(page_id_t *page_id);
+
+  void UpdateRootPageId(int insert_record = 0);
+
+  // member variable
+  std::string index_name_;
+  page_id_t root_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  // the header page that records root_page_id_ under index_name_
+  page_id_t header_page_id_;
+  // guards the whole tree
+  ReaderWriterLatch latch_;
+};
+
+}  // namespace bustub
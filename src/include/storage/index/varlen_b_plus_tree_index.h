@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree_index.h
+//
+// Identification: src/include/storage/index/varlen_b_plus_tree_index.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/index/index.h"
+#include "storage/index/varlen_b_plus_tree.h"
+
+namespace bustub {
+
+/**
+ * B+ tree index whose keys take only as many bytes as their values need.
+ * Key tuples are stored in the KeyEncoder encoding; keys that encode to more
+ * than VARLEN_KEY_MAX_SIZE bytes can not be indexed and are left out.
+ */
+class VarlenBPlusTreeIndex : public Index {
+ public:
+  VarlenBPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                       page_id_t header_page_id = HEADER_PAGE_ID);
+
+  void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+  VarlenBPlusTreeIterator GetBeginIterator();
+
+  VarlenBPlusTreeIterator GetBeginIterator(const Tuple &key);
+
+ protected:
+  // the encoded key; one byte too long if the key does not fit, so that it matches nothing
+  std::string EncodeKey(const Tuple &key) const;
+
+  // container
+  VarlenBPlusTree container_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree_iterator.h
+//
+// Identification: src/include/storage/index/varlen_b_plus_tree_iterator.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/rid.h"
+
+namespace bustub {
+
+using VarlenMappingType = std::pair<std::string, RID>;
+
+class VarlenBPlusTree;
+
+/**
+ * Range-scan iterator over a VarlenBPlusTree.
+ *
+ * The iterator works one leaf at a time: it copies the items of a leaf under
+ * the tree's read latch and keeps no page pinned between calls. Once they are
+ * used up it looks up the last key it returned again and continues with the
+ * keys after it, so it stays valid across concurrent splits and merges; keys
+ * inserted behind it are not seen.
+ */
+class VarlenBPlusTreeIterator {
+ public:
+  /**
+   * Creates an iterator that starts at the first key not less than key.
+   */
+  VarlenBPlusTreeIterator(VarlenBPlusTree *tree, const std::string &key);
+
+  /**
+   * @return true if every key has been visited
+   */
+  bool IsEnd();
+
+  /**
+   * @return the current key-value pair
+   */
+  const VarlenMappingType &operator*();
+
+  /**
+   * Advances to the next pair, loading the next leaf if needed.
+   */
+  VarlenBPlusTreeIterator &operator++();
+
+ private:
+  VarlenBPlusTree *tree_;
+  // pairs of the current leaf
+  std::vector<VarlenMappingType> items_;
+  size_t item_index_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree_internal_page.h
+//
+// Identification: src/include/storage/page/b_epsilon_tree_internal_page.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <climits>
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_EPSILON_TREE_INTERNAL_PAGE_TYPE BEpsilonTreeInternalPage<KeyType, ValueType, KeyComparator>
+#define B_EPSILON_PAGE_HEADER_SIZE 36
+// children per internal page: about the square root of what a page could hold (epsilon = 1/2), the rest of the
+// page is buffer
+#define B_EPSILON_FANOUT 16
+
+/** What a buffered message does to its key once it reaches a leaf */
+enum class BEpsilonMessageType : int32_t { INSERT, DELETE };
+
+/** A pending insert or delete of key, kept in an internal page on its way down to the leaves */
+template <typename KeyType, typename ValueType>
+struct BEpsilonMessage {
+  KeyType key_;
+  ValueType value_;
+  BEpsilonMessageType type_;
+};
+
+/**
+ * Internal page of a BEpsilonTree: up to max_size children with their pivot
+ * keys, laid out like a BPlusTreeInternalPage (the first key is unused), and
+ * a buffer of pending messages filling the rest of the page.
+ *
+ * Messages are sorted by key and there is at most one per key: a newer
+ * message for the same key replaces the older one. The messages bound for a
+ * child are therefore contiguous in the buffer.
+ *
+ * Internal page format:
+ *  ---------------------------------------------------------------------------------------
+ * | HEADER | KEY(0)+PAGE_ID(0) | ... | KEY(max_size-1)+PAGE_ID(max_size-1) | MESSAGE(1) | ...
+ *  ---------------------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 36 bytes in total):
+ *  ---------------------------------------------------------------------
+ * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
+ *  ---------------------------------------------------------------------
+ *  ------------------------------------------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | Version (4) | BufferSize (4) | BufferMaxSize (4) |
+ *  ------------------------------------------------------------------------------------
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BEpsilonTreeInternalPage : public BPlusTreePage {
+  using Pivot = std::pair<KeyType, page_id_t>;
+  using Message = BEpsilonMessage<KeyType, ValueType>;
+
+ public:
+  // must call initialize method after "create" a new node; the buffer is capped at what fits next to max_size children
+  void Init(page_id_t page_id, int max_size = B_EPSILON_FANOUT, int buffer_max_size = INT_MAX);
+
+  KeyType KeyAt(int index) const;
+  page_id_t ValueAt(int index) const;
+  // index of the child whose range covers key
+  int ChildIndex(const KeyType &key, const KeyComparator &comparator) const;
+
+  int GetBufferSize() const;
+  int GetBufferMaxSize() const;
+  bool IsBufferFull() const;
+  const Message &MessageAt(int index) const;
+  // index of the first message whose key is not less than (or, if upper, greater than) key
+  int MessageIndex(const KeyType &key, const KeyComparator &comparator, bool upper = false) const;
+  // the pending message for key, nullptr if there is none
+  const Message *FindMessage(const KeyType &key, const KeyComparator &comparator) const;
+  // buffer message, replacing the one pending for the same key; the buffer must not be full
+  void AddMessage(const Message &message, const KeyComparator &comparator);
+
+  std::vector<Pivot> GetPivots() const;
+  std::vector<Message> GetMessages() const;
+  // replace the children and the buffer; they must fit into max_size and the buffer max size
+  void Reset(const Pivot *pivots, int num_pivots, const Message *messages, int num_messages);
+
+ private:
+  const Message *Messages() const { return reinterpret_cast<const Message *>(array_ + GetMaxSize()); }
+  Message *Messages() { return reinterpret_cast<Message *>(array_ + GetMaxSize()); }
+
+  int buffer_size_;
+  int buffer_max_size_;
+  Pivot array_[0];
+};
+
+}  // namespace bustub
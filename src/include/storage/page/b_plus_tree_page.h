@@ -10,6 +10,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <cstdlib>
@@ -33,12 +34,16 @@ enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
  * It actually serves as a header part for each B+ tree page and
  * contains information shared by both leaf page and internal page.
  *
- * Header format (size in byte, 24 bytes in total):
+ * Header format (size in byte, 28 bytes in total):
  * ----------------------------------------------------------------------------
  * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  * ----------------------------------------------------------------------------
- * | ParentPageId (4) | PageId(4) |
+ * | ParentPageId (4) | PageId(4) | Version (4) |
  * ----------------------------------------------------------------------------
+ *
+ * The version lets the B-link protocol read a page without latching it. A writer
+ * makes it odd before changing the page and even again afterwards; a reader takes
+ * an even version, reads, and retries if the version has moved in the meantime.
  */
 class BPlusTreePage {
  public:
@@ -62,14 +67,23 @@ class BPlusTreePage {
 
   void SetLSN(lsn_t lsn = INVALID_LSN);
 
+  // wait until no writer is changing the page and return its version
+  uint32_t StableVersion() const;
+  // whether the page is unchanged since StableVersion() returned version
+  bool ValidateVersion(uint32_t version) const;
+  // bracket a change to the page; the caller must hold the page's write latch
+  void BeginWrite();
+  void EndWrite();
+
  private:
   // member variable, attributes that both internal and leaf page share
-  IndexPageType page_type_ __attribute__((__unused__));
-  lsn_t lsn_ __attribute__((__unused__));
-  int size_ __attribute__((__unused__));
-  int max_size_ __attribute__((__unused__));
-  page_id_t parent_page_id_ __attribute__((__unused__));
-  page_id_t page_id_ __attribute__((__unused__));
+  IndexPageType page_type_;
+  lsn_t lsn_;
+  int size_;
+  int max_size_;
+  page_id_t parent_page_id_;
+  page_id_t page_id_;
+  std::atomic<uint32_t> version_;
 };
 
 }  // namespace bustub
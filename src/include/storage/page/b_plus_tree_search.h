@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_search.h
+//
+// Identification: src/include/storage/page/b_plus_tree_search.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "storage/index/generic_key.h"
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+/**
+ * Search within the sorted key & value pairs of a B+ tree page.
+ * LowerBound returns the first index in [first, last) whose key is not less
+ * than key, UpperBound the first one whose key is greater than key; both
+ * return last if there is none.
+ *
+ * In general this is a binary search through the comparator. GenericKeys,
+ * which make up every index in the system, get the specialization below.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeSearch {
+ public:
+  static int LowerBound(const MappingType *array, int first, int last, const KeyType &key,
+                        const KeyComparator &comparator) {
+    return Search<false>(array, first, last, key, comparator);
+  }
+
+  static int UpperBound(const MappingType *array, int first, int last, const KeyType &key,
+                        const KeyComparator &comparator) {
+    return Search<true>(array, first, last, key, comparator);
+  }
+
+ private:
+  template <bool Upper>
+  static int Search(const MappingType *array, int first, int last, const KeyType &key,
+                    const KeyComparator &comparator) {
+    while (first < last) {
+      int mid = first + (last - first) / 2;
+      int cmp = comparator(array[mid].first, key);
+      if (cmp < 0 || (Upper && cmp == 0)) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
+    }
+    return first;
+  }
+};
+
+/**
+ * Search over GenericKeys, specialized on the key size.
+ *
+ * GenericKeys are memcmp-comparable, so the first 8 bytes of a key, read as a
+ * big-endian integer, order keys like the whole key does. The search compares
+ * those integers and only looks at the rest of the key on ties. It runs in
+ * three phases:
+ * - 8-byte keys hold nothing but that integer, so for them (e.g. a single
+ *   BIGINT column) up to two interpolation probes guess the position of the
+ *   key from the first and last key of the range. Each probe is checked
+ *   against an entry one window away, which brackets the key within a single
+ *   window when the keys are spread evenly.
+ * - A binary search narrows the range down to a window, prefetching both
+ *   entries the next step may probe while it compares the current one.
+ * - The window, a few cache lines of entries, is scanned front to back
+ *   without branching on the outcome, counting the entries before the key.
+ */
+template <size_t KeySize, typename ValueType>
+class BPlusTreeSearch<GenericKey<KeySize>, ValueType, GenericComparator<KeySize>> {
+  using KeyType = GenericKey<KeySize>;
+  using KeyComparator = GenericComparator<KeySize>;
+
+ public:
+  static int LowerBound(const MappingType *array, int first, int last, const KeyType &key,
+                        const KeyComparator & /* comparator */) {
+    return Search<false>(array, first, last, key);
+  }
+
+  static int UpperBound(const MappingType *array, int first, int last, const KeyType &key,
+                        const KeyComparator & /* comparator */) {
+    return Search<true>(array, first, last, key);
+  }
+
+ private:
+  // the number of entries scanned linearly, about four cache lines worth
+  static constexpr int WINDOW = std::max<int>(4, 256 / sizeof(MappingType));
+
+  // the first 8 bytes of key as a big-endian integer, padded with zeros for shorter keys
+  static uint64_t Head(const KeyType &key) {
+    uint64_t head = 0;
+    memcpy(&head, key.data_, std::min(KeySize, sizeof(head)));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    head = __builtin_bswap64(head);
+#endif
+    return head;
+  }
+
+  // whether entry sorts before the search position: it is less than key, or not greater if Upper
+  template <bool Upper>
+  static bool Before(const KeyType &entry, const KeyType &key, uint64_t key_head) {
+    uint64_t head = Head(entry);
+    if constexpr (KeySize > sizeof(uint64_t)) {
+      if (head == key_head) {
+        int cmp = memcmp(entry.data_ + sizeof(uint64_t), key.data_ + sizeof(uint64_t), KeySize - sizeof(uint64_t));
+        return Upper ? cmp <= 0 : cmp < 0;
+      }
+    }
+    return Upper ? head <= key_head : head < key_head;
+  }
+
+  // the result always lies in [first, last]
+  template <bool Upper>
+  static int Search(const MappingType *array, int first, int last, const KeyType &key) {
+    uint64_t key_head = Head(key);
+
+    if constexpr (KeySize == sizeof(uint64_t)) {
+      for (int probe = 0; probe < 2 && last - first > WINDOW; probe++) {
+        uint64_t low_head = Head(array[first].first);
+        uint64_t high_head = Head(array[last - 1].first);
+        if (key_head <= low_head || key_head >= high_head) {
+          break;
+        }
+        int guess = first + static_cast<int>(static_cast<double>(key_head - low_head) /
+                                             static_cast<double>(high_head - low_head) * (last - 1 - first));
+        if (Before<Upper>(array[guess].first, key, key_head)) {
+          first = guess + 1;
+          if (guess + WINDOW < last && !Before<Upper>(array[guess + WINDOW].first, key, key_head)) {
+            last = guess + WINDOW;
+          }
+        } else {
+          last = guess;
+          if (guess - WINDOW >= first && Before<Upper>(array[guess - WINDOW].first, key, key_head)) {
+            first = guess - WINDOW + 1;
+          }
+        }
+      }
+    }
+
+    while (last - first > WINDOW) {
+      int half = (last - first) / 2;
+      int mid = first + half;
+      __builtin_prefetch(&array[first + half / 2]);
+      __builtin_prefetch(&array[mid + half / 2]);
+      if (Before<Upper>(array[mid].first, key, key_head)) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
+    }
+
+    int before = 0;
+    for (int i = first; i < last; i++) {
+      before += static_cast<int>(Before<Upper>(array[i].first, key, key_head));
+    }
+    return first + before;
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         CMU-DB Project (15-445/645)
+//                         ***DO NO SHARE PUBLICLY***
+//
+// Identification: src/include/page/b_plus_tree_varlen_page.h
+//
+// Copyright (c) 2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_VARLEN_PAGE_TYPE BPlusTreeVarlenPage<ValueType>
+#define VARLEN_PAGE_HEADER_SIZE 44
+
+// the longest key a varlen page accepts, small enough that a split always yields two pages that fit
+static constexpr uint32_t VARLEN_KEY_MAX_SIZE = 512;
+
+/**
+ * Slotted B+ tree page for variable-length byte-string keys, compared with
+ * memcmp. Leaf pages map keys to RIDs, internal pages map them to child page
+ * ids; as in BPlusTreeInternalPage, the first key of an internal page is
+ * unused and its first child covers everything below the second key.
+ *
+ * Every page carries two fence keys: all keys stored in the page, or below
+ * it, are at least the low fence and smaller than the high fence (the
+ * rightmost page of a level has none). Keys within the fences all start with
+ * the fences' common prefix, so the page stores only what follows it. The
+ * fences are fixed when the page is created or rebuilt, which keeps the
+ * prefix stable across inserts and removals.
+ *
+ * Page format (slots grow forward, keys grow backward from the fences):
+ *  ---------------------------------------------------------------------------------
+ * | HEADER | SLOT(1) | ... | SLOT(n) | FREE SPACE | KEY(n) ... KEY(1) | HIGH | LOW |
+ *  ---------------------------------------------------------------------------------
+ * Keys are not kept in slot order in the key area; removals leave holes that
+ * are compacted away when an insert needs the room.
+ *
+ *  Header format (size in byte, 44 bytes in total):
+ *  ---------------------------------------------------------------------
+ * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
+ *  ---------------------------------------------------------------------
+ *  ---------------------------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | Version (4) | NextPageId (4) |
+ *  ---------------------------------------------------------------------
+ *  ---------------------------------------------------------------------
+ * | KeyBegin (2) | KeyBytes (2) | PrefixLength (2) | LowFenceLength (2) |
+ *  ---------------------------------------------------------------------
+ *  -----------------------------------------
+ * | HighFenceLength (2) | Reserved (2) |
+ *  -----------------------------------------
+ *  Slot format: | KeyOffset (2) | KeyLength (2) | Value |
+ */
+template <typename ValueType>
+class BPlusTreeVarlenPage : public BPlusTreePage {
+ public:
+  // must call initialize method after "create" a new node; high_fence is nullptr for the rightmost page
+  void Init(page_id_t page_id, IndexPageType page_type, std::string_view low_fence, const std::string *high_fence);
+
+  page_id_t GetNextPageId() const;
+  void SetNextPageId(page_id_t next_page_id);
+
+  std::string_view GetLowFence() const;
+  bool HasHighFence() const;
+  std::string_view GetHighFence() const;
+  // the bytes every key of this page starts with
+  std::string_view GetPrefix() const;
+
+  std::string KeyAt(int index) const;
+  ValueType ValueAt(int index) const;
+  void SetValueAt(int index, const ValueType &value);
+
+  // index of the first key not less than key
+  int LowerBound(std::string_view key) const;
+  // internal pages: index of the child whose range covers key
+  int ChildIndex(std::string_view key) const;
+
+  // insert at index, compacting if needed; false if the page has no room left
+  bool Insert(int index, std::string_view key, const ValueType &value);
+  void Remove(int index);
+
+  // all entries with their full keys
+  std::vector<std::pair<std::string, ValueType>> GetEntries() const;
+  // whether Reset with these fences and entries would succeed
+  static bool Fits(std::string_view low_fence, const std::string *high_fence,
+                   const std::vector<std::pair<std::string, ValueType>> &entries, bool is_leaf);
+  // replace the fences and the content of the page; the entries must fit
+  void Reset(std::string_view low_fence, const std::string *high_fence,
+             const std::vector<std::pair<std::string, ValueType>> &entries);
+
+  // bytes taken by slots and keys, i.e. everything but the header and the fences
+  int GetUsedBytes() const;
+  // what GetUsedBytes() can grow to in an empty page
+  static int Capacity();
+
+ private:
+  struct Slot {
+    uint16_t key_offset_;
+    uint16_t key_length_;
+    ValueType value_;
+  };
+
+  static constexpr uint16_t NO_HIGH_FENCE = UINT16_MAX;
+
+  std::string_view SuffixAt(int index) const;
+  // the first index whose key is not less than (or, if upper, greater than) key
+  int Search(std::string_view key, bool upper) const;
+  // the first byte of the fences
+  int FenceBegin() const;
+  // move the keys next to the fences, closing the holes left by removals
+  void Compact();
+
+  const char *Data() const { return reinterpret_cast<const char *>(this); }
+  char *Data() { return reinterpret_cast<char *>(this); }
+
+  page_id_t next_page_id_;
+  uint16_t key_begin_;
+  uint16_t key_bytes_;
+  uint16_t prefix_length_;
+  uint16_t low_fence_length_;
+  uint16_t high_fence_length_;
+  uint16_t reserved_;
+  Slot slots_[0];
+};
+}  // namespace bustub
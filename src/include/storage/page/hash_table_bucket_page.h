@@ -85,6 +85,16 @@ class HashTableBucketPage {
    */
   void RemoveAt(uint32_t bucket_idx);
 
+  /**
+   * Puts a KV pair at bucket_idx and marks the slot occupied and readable.
+   * No duplicate check is performed; used when a bucket is filled in bulk.
+   *
+   * @param bucket_idx the index in the bucket to put the pair at
+   * @param key key to put
+   * @param value value to put
+   */
+  void InsertAt(uint32_t bucket_idx, const KeyType &key, const ValueType &value);
+
   /**
    * Returns whether or not an index is occupied (key/value pair or tombstone)
    *
@@ -19,6 +19,7 @@
 #include "recovery/log_manager.h"
 #include "storage/page/page.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_filter.h"
 
 static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
 
@@ -122,20 +123,30 @@ class TablePage : public Page {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
 
+  /**
+   * Check a tuple against a filter on its bytes in the page, without reading it out or locking it.
+   * @param rid rid of the tuple to check
+   * @param filter the filter
+   * @return true if the tuple exists and the filter lets it through
+   */
+  bool TupleMatches(const RID &rid, const TupleFilter &filter);
+
   /** @return the rid of the first tuple in this page */
 
   /**
    * @param[out] first_rid the RID of the first tuple in this page
+   * @param filter if not nullptr, tuples it rejects are skipped
    * @return true if the first tuple exists, false otherwise
    */
-  bool GetFirstTupleRid(RID *first_rid);
+  bool GetFirstTupleRid(RID *first_rid, const TupleFilter *filter = nullptr);
 
   /**
    * @param cur_rid the RID of the current tuple
    * @param[out] next_rid the RID of the tuple following the current tuple
+   * @param filter if not nullptr, tuples it rejects are skipped
    * @return true if the next tuple exists, false otherwise
    */
-  bool GetNextTupleRid(const RID &cur_rid, RID *next_rid);
+  bool GetNextTupleRid(const RID &cur_rid, RID *next_rid, const TupleFilter *filter = nullptr);
 
  private:
   static_assert(sizeof(page_id_t) == 4);
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
@@ -99,12 +101,43 @@ class TableHeap {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
 
-  /** @return the begin iterator of this table */
-  TableIterator Begin(Transaction *txn);
+  /**
+   * Check a tuple against a filter on its bytes in the page, without reading it out or locking it.
+   * @param rid rid of the tuple to check
+   * @param filter the filter
+   * @return true if the tuple exists and the filter lets it through
+   */
+  bool TupleMatches(const RID &rid, const TupleFilter &filter);
+
+  /**
+   * @param txn transaction performing the scan
+   * @param filter if not nullptr, the iterator skips the tuples it rejects; it must outlive the iterator
+   * @return the begin iterator of this table
+   */
+  TableIterator Begin(Transaction *txn, const TupleFilter *filter = nullptr);
 
   /** @return the end iterator of this table */
   TableIterator End();
 
+  /**
+   * Collect the ids of all pages of this table, e.g. to split a scan among workers.
+   * @param[out] page_ids the page ids are appended here, in chain order
+   * @return false if a page could not be fetched, in which case page_ids stops short
+   */
+  bool GetPageIds(std::vector<page_id_t> *page_ids);
+
+  /**
+   * Read every tuple on one page of this table. Unlike the other readers, a page that cannot be fetched does not
+   * abort txn, so that workers sharing a transaction can call this; the caller decides what a failed read means.
+   * @param page_id the page to read, one of GetPageIds()
+   * @param[out] tuples the tuples of the page are appended here
+   * @param txn the transaction performing the read
+   * @param filter if not nullptr, the tuples it rejects are skipped
+   * @return false if the page or a tuple on it could not be read
+   */
+  bool GetPageTuples(page_id_t page_id, std::vector<Tuple> *tuples, Transaction *txn,
+                     const TupleFilter *filter = nullptr);
+
   /** @return the id of the first page of this table */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
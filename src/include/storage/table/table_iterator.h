@@ -17,6 +17,7 @@
 #include "common/rid.h"
 #include "concurrency/transaction.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_filter.h"
 
 namespace bustub {
 
@@ -29,10 +30,10 @@ class TableIterator {
   friend class Cursor;
 
  public:
-  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn);
+  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, const TupleFilter *filter = nullptr);
 
   TableIterator(const TableIterator &other)
-      : table_heap_(other.table_heap_), tuple_(new Tuple(*other.tuple_)), txn_(other.txn_) {}
+      : table_heap_(other.table_heap_), tuple_(new Tuple(*other.tuple_)), txn_(other.txn_), filter_(other.filter_) {}
 
   ~TableIterator() { delete tuple_; }
 
@@ -52,6 +53,7 @@ class TableIterator {
     table_heap_ = other.table_heap_;
     *tuple_ = *other.tuple_;
     txn_ = other.txn_;
+    filter_ = other.filter_;
     return *this;
   }
 
@@ -59,6 +61,8 @@ class TableIterator {
   TableHeap *table_heap_;
   Tuple *tuple_;
   Transaction *txn_;
+  // if not nullptr, the tuples it rejects are skipped without being copied
+  const TupleFilter *filter_;
 };
 
 }  // namespace bustub
@@ -4,8 +4,7 @@
 
 namespace bustub {
 
-// Document this class! What does it represent?
-
+/** TmpTuple identifies a tuple in a TmpTuplePage by the page it is on and its offset within the page. */
 class TmpTuple {
  public:
   TmpTuple(page_id_t page_id, size_t offset) : page_id_(page_id), offset_(offset) {}
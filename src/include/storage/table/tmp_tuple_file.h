@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is an append-only run of TmpTuplePages that an executor
+ * spills tuples into when they outgrow its memory budget.
+ *
+ * Tuples are appended to a page kept outside the buffer pool, which is copied
+ * into a new buffer pool page once it is full; so a file holds no frame
+ * pinned between calls, and one whose tuples fit in a page never touches the
+ * buffer pool at all. The pages are deleted along with the file.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(BufferPoolManager *bpm);
+
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /**
+   * Append a tuple to the file.
+   * @param tuple The tuple to append, which must fit in an empty page
+   * @throw Exception if the buffer pool has no frame for a new page
+   */
+  void Append(const Tuple &tuple);
+
+  /** @return The number of pages holding tuples, the one still being filled included */
+  std::size_t GetPageCount() { return page_ids_.size() + (tail_.GetFreeSpacePointer() < PAGE_SIZE ? 1 : 0); }
+
+  /**
+   * Read the tuples of a page, in the reverse of the order they were appended in.
+   * @param index The index of the page, below GetPageCount()
+   * @param[out] tuples The tuples of the page
+   * @throw Exception if the buffer pool has no frame to read the page into
+   */
+  void ReadPage(std::size_t index, std::vector<Tuple> *tuples);
+
+ private:
+  /** Copy the tail page into a new buffer pool page and start a new tail. */
+  void FlushTail();
+
+  BufferPoolManager *bpm_;
+  /** The full pages, in the order they were filled */
+  std::vector<page_id_t> page_ids_;
+  /** The page being filled, not in the buffer pool */
+  TmpTuplePage tail_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,36 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_filter.h
+//
+// Identification: src/include/storage/table/tuple_filter.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+namespace bustub {
+
+/**
+ * TupleFilter lets a TableIterator skip tuples by looking at their bytes in
+ * the table page, before they are copied out of it (and, by the executor
+ * above, locked).
+ *
+ * A filter may let through tuples that the query will still drop, but must
+ * never reject one that the query would keep.
+ */
+class TupleFilter {
+ public:
+  virtual ~TupleFilter() = default;
+
+  /**
+   * @param data The serialized tuple, inside the latched table page
+   * @return `false` if the tuple can be skipped
+   */
+  virtual bool Matches(const char *data) const = 0;
+};
+
+}  // namespace bustub
@@ -0,0 +1,394 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree.cpp
+//
+// Identification: src/storage/index/b_epsilon_tree.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/index/b_epsilon_tree.h"
+#include "storage/page/header_page.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+B_EPSILON_TREE_TYPE::BEpsilonTree(std::string name, BufferPoolManager *buffer_pool_manager,
+                                  const KeyComparator &comparator, int leaf_max_size, int internal_max_size,
+                                  int buffer_max_size, page_id_t header_page_id)
+    : index_name_(std::move(name)),
+      root_page_id_(INVALID_PAGE_ID),
+      buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      leaf_max_size_(leaf_max_size),
+      internal_max_size_(internal_max_size),
+      buffer_max_size_(buffer_max_size),
+      header_page_id_(header_page_id) {}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool B_EPSILON_TREE_TYPE::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * Return the only value that associated with input key. The first message
+ * for key on the way down is the newest one and overrides the leaf.
+ * @return : true means key exists
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool B_EPSILON_TREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) {
+  latch_.RLock();
+  page_id_t page_id = root_page_id_;
+  bool found = false;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = FetchPage(page_id);
+    page_id_t child_page_id = INVALID_PAGE_ID;
+    if (reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+      ValueType value;
+      found = reinterpret_cast<LeafPage *>(page->GetData())->Lookup(key, &value, comparator_);
+      if (found) {
+        result->push_back(value);
+      }
+    } else {
+      auto *node = reinterpret_cast<InternalPage *>(page->GetData());
+      const Message *message = node->FindMessage(key, comparator_);
+      if (message != nullptr) {
+        found = message->type_ == BEpsilonMessageType::INSERT;
+        if (found) {
+          result->push_back(message->value_);
+        }
+      } else {
+        child_page_id = node->ValueAt(node->ChildIndex(key, comparator_));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child_page_id;
+  }
+  latch_.RUnlock();
+  return found;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::GetRange(const KeyType &low, const KeyType &high, std::vector<MappingType> *result,
+                                   Transaction *transaction) {
+  latch_.RLock();
+  if (!IsEmpty()) {
+    Collect(root_page_id_, low, high, result);
+  }
+  latch_.RUnlock();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::Collect(page_id_t page_id, const KeyType &low, const KeyType &high,
+                                  std::vector<MappingType> *result) {
+  Page *page = FetchPage(page_id);
+  if (reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    for (int i = leaf->KeyIndex(low, comparator_); i < leaf->UpperKeyIndex(high, comparator_); i++) {
+      result->push_back(leaf->GetItem(i));
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    return;
+  }
+
+  // what the children in range hold, with this page's messages on top
+  auto *node = reinterpret_cast<InternalPage *>(page->GetData());
+  std::vector<MappingType> below;
+  int last_child = node->ChildIndex(high, comparator_);
+  for (int i = node->ChildIndex(low, comparator_); i <= last_child; i++) {
+    Collect(node->ValueAt(i), low, high, &below);
+  }
+  int first_message = node->MessageIndex(low, comparator_);
+  int last_message = node->MessageIndex(high, comparator_, true);
+  auto entries = ApplyMessages(below, &node->MessageAt(0) + first_message, &node->MessageAt(0) + last_message);
+  result->insert(result->end(), entries.begin(), entries.end());
+  buffer_pool_manager_->UnpinPage(page_id, false);
+}
+
+/*****************************************************************************
+ * INSERTION AND REMOVAL
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  Put({key, value, BEpsilonMessageType::INSERT});
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  Put({key, ValueType(), BEpsilonMessageType::DELETE});
+}
+
+/*
+ * A root leaf takes the message right away. A root internal page buffers it
+ * and only once the buffer is full pushes messages down; the root splits
+ * into as many pages as that takes, under a new root.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::Put(const Message &message) {
+  latch_.WLock();
+  if (IsEmpty()) {
+    if (message.type_ == BEpsilonMessageType::DELETE) {
+      latch_.WUnlock();
+      return;
+    }
+    page_id_t page_id;
+    auto *leaf = reinterpret_cast<LeafPage *>(NewPage(&page_id)->GetData());
+    leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+    root_page_id_ = page_id;
+    UpdateRootPageId(1);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+  }
+
+  std::vector<Message> messages;
+  Page *page = FetchPage(root_page_id_);
+  if (reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+    messages.push_back(message);
+    buffer_pool_manager_->UnpinPage(root_page_id_, false);
+  } else {
+    auto *root = reinterpret_cast<InternalPage *>(page->GetData());
+    root->AddMessage(message, comparator_);
+    bool full = root->IsBufferFull();
+    buffer_pool_manager_->UnpinPage(root_page_id_, true);
+    if (!full) {
+      latch_.WUnlock();
+      return;
+    }
+  }
+
+  bool emptied = false;
+  auto siblings = PushDown(root_page_id_, messages, &emptied);
+  if (emptied) {
+    buffer_pool_manager_->DeletePage(root_page_id_);
+    root_page_id_ = INVALID_PAGE_ID;
+    UpdateRootPageId();
+  }
+  while (!siblings.empty()) {
+    std::vector<Pivot> pivots{{KeyType(), root_page_id_}};
+    pivots.insert(pivots.end(), siblings.begin(), siblings.end());
+    page_id_t page_id;
+    auto *root = reinterpret_cast<InternalPage *>(NewPage(&page_id)->GetData());
+    root->Init(page_id, internal_max_size_, buffer_max_size_);
+    siblings = WriteInternals(root, pivots, {});
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    root_page_id_ = page_id;
+    UpdateRootPageId();
+  }
+  latch_.WUnlock();
+}
+
+/*
+ * A leaf applies the messages to its entries. An internal page adds them to
+ * its buffer and, as long as the buffer is full, flushes the messages bound
+ * for the child with the most of them into that child, linking in whatever
+ * pages the child split into and unlinking it if it is an emptied leaf.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_TYPE::PushDown(page_id_t page_id, const std::vector<Message> &messages, bool *emptied)
+    -> std::vector<Pivot> {
+  Page *page = FetchPage(page_id);
+  std::vector<Pivot> siblings;
+  if (reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    std::vector<MappingType> entries;
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      entries.push_back(leaf->GetItem(i));
+    }
+    entries = ApplyMessages(entries, messages.data(), messages.data() + messages.size());
+    *emptied = entries.empty();
+    siblings = WriteLeaves(leaf, entries);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    return siblings;
+  }
+
+  auto *node = reinterpret_cast<InternalPage *>(page->GetData());
+  auto pivots = node->GetPivots();
+  auto buffer = MergeMessages(node->GetMessages(), messages);
+  auto message_less = [&](const Message &m, const KeyType &key) { return comparator_(m.key_, key) < 0; };
+  while (!buffer.empty() && static_cast<int>(buffer.size()) >= node->GetBufferMaxSize()) {
+    // the messages bound for each child are contiguous, starting at the child's pivot
+    size_t child = 0;
+    auto first = buffer.begin();
+    auto last = buffer.begin();
+    auto begin = buffer.begin();
+    for (size_t i = 0; i < pivots.size(); i++) {
+      auto end = i + 1 < pivots.size() ? std::lower_bound(begin, buffer.end(), pivots[i + 1].first, message_less)
+                                       : buffer.end();
+      if (end - begin > last - first) {
+        child = i;
+        first = begin;
+        last = end;
+      }
+      begin = end;
+    }
+
+    std::vector<Message> batch(first, last);
+    buffer.erase(first, last);
+    bool child_emptied = false;
+    auto child_siblings = PushDown(pivots[child].second, batch, &child_emptied);
+    pivots.insert(pivots.begin() + child + 1, child_siblings.begin(), child_siblings.end());
+    if (child_emptied && pivots.size() > 1) {
+      buffer_pool_manager_->DeletePage(pivots[child].second);
+      pivots.erase(pivots.begin() + child);
+    }
+  }
+  siblings = WriteInternals(node, pivots, buffer);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return siblings;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_TYPE::WriteLeaves(LeafPage *leaf, const std::vector<MappingType> &entries)
+    -> std::vector<Pivot> {
+  // the fewest pages that hold entries, evenly filled
+  size_t num_pages = std::max<size_t>(1, (entries.size() + leaf_max_size_ - 1) / leaf_max_size_);
+  std::vector<Pivot> siblings;
+  for (size_t i = 0; i < num_pages; i++) {
+    size_t begin = entries.size() * i / num_pages;
+    size_t end = entries.size() * (i + 1) / num_pages;
+    LeafPage *page = leaf;
+    if (i > 0) {
+      page_id_t page_id;
+      page = reinterpret_cast<LeafPage *>(NewPage(&page_id)->GetData());
+      page->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+      siblings.emplace_back(entries[begin].first, page_id);
+    }
+    page->SetSize(0);
+    for (size_t j = begin; j < end; j++) {
+      page->CopyLastFrom(entries[j]);
+    }
+    if (i > 0) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    }
+  }
+  return siblings;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_TYPE::WriteInternals(InternalPage *node, const std::vector<Pivot> &pivots,
+                                         const std::vector<Message> &messages) -> std::vector<Pivot> {
+  size_t num_pages = (pivots.size() + internal_max_size_ - 1) / internal_max_size_;
+  std::vector<Pivot> siblings;
+  auto message = messages.begin();
+  for (size_t i = 0; i < num_pages; i++) {
+    size_t begin = pivots.size() * i / num_pages;
+    size_t end = pivots.size() * (i + 1) / num_pages;
+    // the messages below the next page's pivot belong to this one
+    auto message_end =
+        end < pivots.size()
+            ? std::lower_bound(message, messages.end(), pivots[end].first,
+                               [&](const Message &m, const KeyType &key) { return comparator_(m.key_, key) < 0; })
+            : messages.end();
+    InternalPage *page = node;
+    if (i > 0) {
+      page_id_t page_id;
+      page = reinterpret_cast<InternalPage *>(NewPage(&page_id)->GetData());
+      page->Init(page_id, internal_max_size_, buffer_max_size_);
+      siblings.push_back({pivots[begin].first, page_id});
+    }
+    page->Reset(pivots.data() + begin, static_cast<int>(end - begin), messages.data() + (message - messages.begin()),
+                static_cast<int>(message_end - message));
+    if (i > 0) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    }
+    message = message_end;
+  }
+  return siblings;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_TYPE::ApplyMessages(const std::vector<MappingType> &entries, const Message *first,
+                                        const Message *last) const -> std::vector<MappingType> {
+  std::vector<MappingType> result;
+  auto entry = entries.begin();
+  while (entry != entries.end() || first != last) {
+    int cmp = entry == entries.end() ? 1 : first == last ? -1 : comparator_(entry->first, first->key_);
+    if (cmp < 0) {
+      result.push_back(*entry++);
+      continue;
+    }
+    if (first->type_ == BEpsilonMessageType::INSERT) {
+      result.emplace_back(first->key_, first->value_);
+    }
+    if (cmp == 0) {
+      entry++;
+    }
+    first++;
+  }
+  return result;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_TYPE::MergeMessages(const std::vector<Message> &older, const std::vector<Message> &newer) const
+    -> std::vector<Message> {
+  std::vector<Message> result;
+  auto old_message = older.begin();
+  auto new_message = newer.begin();
+  while (old_message != older.end() || new_message != newer.end()) {
+    int cmp = old_message == older.end()   ? 1
+              : new_message == newer.end() ? -1
+                                           : comparator_(old_message->key_, new_message->key_);
+    if (cmp < 0) {
+      result.push_back(*old_message++);
+      continue;
+    }
+    if (cmp == 0) {
+      old_message++;
+    }
+    result.push_back(*new_message++);
+  }
+  return result;
+}
+
+/*****************************************************************************
+ * UTILITIES
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+Page *B_EPSILON_TREE_TYPE::FetchPage(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch page");
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *B_EPSILON_TREE_TYPE::NewPage(page_id_t *page_id) {
+  Page *page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+  }
+  return page;
+}
+
+/*
+ * Update/Insert root page id in header page(header_page_id_, page 0 unless the
+ * tree was given its own)
+ * @parameter: insert_record      defualt value is false. When set to true,
+ * insert a record <index_name, root_page_id> into header page instead of
+ * updating it.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_TYPE::UpdateRootPageId(int insert_record) {
+  auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id_));
+  if (insert_record == 0 || !header_page->InsertRecord(index_name_, root_page_id_)) {
+    header_page->UpdateRecord(index_name_, root_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
+}
+
+template class BEpsilonTree<GenericKey<4>, RID, GenericComparator<4>>;
+template class BEpsilonTree<GenericKey<8>, RID, GenericComparator<8>>;
+template class BEpsilonTree<GenericKey<16>, RID, GenericComparator<16>>;
+template class BEpsilonTree<GenericKey<32>, RID, GenericComparator<32>>;
+template class BEpsilonTree<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree_index.cpp
+//
+// Identification: src/storage/index/b_epsilon_tree_index.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/b_epsilon_tree_index.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+INDEX_TEMPLATE_ARGUMENTS
+B_EPSILON_TREE_INDEX_TYPE::BEpsilonTreeIndex(std::unique_ptr<IndexMetadata> &&metadata,
+                                             BufferPoolManager *buffer_pool_manager, page_id_t header_page_id)
+    : Index(std::move(metadata)),
+      comparator_(GetMetadata()->GetKeySchema()),
+      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, LEAF_PAGE_SIZE, B_EPSILON_FANOUT, INT_MAX,
+                 header_page_id) {
+  if (sizeof(KeyType) <= RID_SUFFIX_SIZE) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "key is too short for a B-epsilon tree index");
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INDEX_TYPE::MakeKey(const Tuple &key, const RID &rid, KeyType *index_key) const {
+  if constexpr (sizeof(KeyType) > RID_SUFFIX_SIZE) {
+    index_key->SetFromKey(key, GetKeySchema(), rid);
+  } else {
+    // unreachable, the constructor rejects such keys
+    index_key->SetFromKey(key, GetKeySchema());
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  KeyType index_key;
+  MakeKey(key, rid, &index_key);
+  container_.Insert(index_key, rid, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  KeyType index_key;
+  MakeKey(key, rid, &index_key);
+  container_.Remove(index_key, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  ScanRange(key, key, result, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INDEX_TYPE::ScanRange(const Tuple &low_key, const Tuple &high_key, std::vector<RID> *result,
+                                          Transaction *transaction) {
+  KeyType low;
+  KeyType high;
+  MakeKey(low_key, RID_SUFFIX_MIN, &low);
+  MakeKey(high_key, RID_SUFFIX_MAX, &high);
+  std::vector<MappingType> entries;
+  container_.GetRange(low, high, &entries, transaction);
+  for (const auto &entry : entries) {
+    result->push_back(entry.second);
+  }
+}
+
+template class BEpsilonTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class BEpsilonTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class BEpsilonTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class BEpsilonTreeIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class BEpsilonTreeIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -9,7 +9,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "common/exception.h"
 #include "common/rid.h"
@@ -19,19 +21,23 @@
 namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                          int leaf_max_size, int internal_max_size)
+                          int leaf_max_size, int internal_max_size, BPlusTreeProtocol protocol,
+                          page_id_t header_page_id)
     : index_name_(std::move(name)),
       root_page_id_(INVALID_PAGE_ID),
       buffer_pool_manager_(buffer_pool_manager),
       comparator_(comparator),
       leaf_max_size_(leaf_max_size),
-      internal_max_size_(internal_max_size) {}
+      // an internal page holds max_size + 1 children right before it splits
+      internal_max_size_(std::min(internal_max_size, static_cast<int>(INTERNAL_PAGE_SIZE) - 1)),
+      protocol_(protocol),
+      header_page_id_(header_page_id) {}
 
 /*
  * Helper function to decide whether current b+tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::IsEmpty() const { return true; }
+bool BPLUSTREE_TYPE::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -42,7 +48,22 @@ bool BPLUSTREE_TYPE::IsEmpty() const { return true; }
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) {
-  return false;
+  if (protocol_ == BPlusTreeProtocol::B_LINK) {
+    return GetValueBLink(key, result);
+  }
+  Page *leaf_page = FindLeafPageOptimistic(key, false, Operation::READ);
+  if (leaf_page == nullptr) {
+    return false;
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  ValueType value;
+  bool found = leaf->Lookup(key, &value, comparator_);
+  leaf_page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+  if (found) {
+    result->push_back(value);
+  }
+  return found;
 }
 
 /*****************************************************************************
@@ -56,7 +77,41 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  * keys return false, otherwise return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) { return false; }
+bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  if (protocol_ == BPlusTreeProtocol::B_LINK) {
+    return InsertBLink(key, value);
+  }
+  if (transaction == nullptr) {
+    Transaction txn(INVALID_TXN_ID);
+    return Insert(key, value, &txn);
+  }
+
+  // fast path: only the leaf is write latched, which is enough as long as it does not split
+  Page *leaf_page = FindLeafPageOptimistic(key, false, Operation::INSERT);
+  if (leaf_page != nullptr) {
+    auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+    ValueType old_value;
+    bool duplicate = leaf->Lookup(key, &old_value, comparator_);
+    bool safe = !duplicate && IsSafe(leaf, Operation::INSERT);
+    if (safe) {
+      leaf->Insert(key, value, comparator_);
+    }
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), safe);
+    if (duplicate || safe) {
+      return !duplicate;
+    }
+  }
+
+  root_latch_.WLock();
+  transaction->AddIntoPageSet(nullptr);
+  if (IsEmpty()) {
+    StartNewTree(key, value);
+    ReleaseLatches(transaction, true);
+    return true;
+  }
+  return InsertIntoLeaf(key, value, transaction);
+}
 /*
  * Insert constant key & value pair into an empty tree
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
@@ -64,19 +119,45 @@ bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  * tree's root page id and insert entry directly into leaf page.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {}
+void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+  leaf->Insert(key, value, comparator_);
+  root_page_id_ = page_id;
+  UpdateRootPageId(1);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
 
 /*
  * Insert constant key & value pair into leaf page
  * User needs to first find the right leaf page as insertion target, then look
  * through leaf page to see whether insert key exist or not. If exist, return
  * immdiately, otherwise insert entry. Remember to deal with split if necessary.
+ * root_latch_ must already be write locked and recorded in the page set.
  * @return: since we only support unique key, if user try to insert duplicate
  * keys return false, otherwise return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction) {
-  return false;
+  Page *leaf_page = FindLeafPagePessimistic(key, Operation::INSERT, transaction);
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  int size = leaf->GetSize();
+  if (leaf->Insert(key, value, comparator_) == size) {
+    ReleaseLatches(transaction, false);
+    return false;
+  }
+  if (leaf->GetSize() >= leaf->GetMaxSize()) {
+    LeafPage *new_leaf = Split(leaf);
+    InsertIntoParent(leaf, new_leaf->KeyAt(0), new_leaf, transaction);
+    buffer_pool_manager_->UnpinPage(new_leaf->GetPageId(), true);
+  }
+  ReleaseLatches(transaction, true);
+  return true;
 }
 
 /*
@@ -85,11 +166,48 @@ bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value,
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
  * an "out of memory" exception if returned value is nullptr), then move half
  * of key & value pairs from input page to newly created page
+ * The new page takes over the right link and high key of the input page and
+ * becomes its right sibling; for leaves, the page to its right (latched here,
+ * left to right) links back to it.
+ * The new page is returned pinned, and its Page through new_page if given.
+ * Under latch crabbing it needs no latch since it is only reachable through
+ * pages the caller holds write latched.
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
-N *BPLUSTREE_TYPE::Split(N *node) {
-  return nullptr;
+N *BPLUSTREE_TYPE::Split(N *node, Page **new_page) {
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+  }
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *new_leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    new_leaf->Init(page_id, leaf->GetParentPageId(), leaf->GetMaxSize());
+    leaf->MoveHalfTo(new_leaf);
+    new_leaf->SetNextPageId(leaf->GetNextPageId());
+    new_leaf->SetPrevPageId(leaf->GetPageId());
+    new_leaf->SetHighKey(leaf->GetHighKey());
+    leaf->SetNextPageId(page_id);
+    leaf->SetHighKey(new_leaf->KeyAt(0));
+    if (new_leaf->GetNextPageId() != INVALID_PAGE_ID) {
+      SetPrevLink(new_leaf->GetNextPageId(), page_id);
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *new_internal = reinterpret_cast<InternalPage *>(page->GetData());
+    new_internal->Init(page_id, internal->GetParentPageId(), internal->GetMaxSize());
+    internal->MoveHalfTo(new_internal, buffer_pool_manager_);
+    new_internal->SetNextPageId(internal->GetNextPageId());
+    new_internal->SetHighKey(internal->GetHighKey());
+    internal->SetNextPageId(page_id);
+    internal->SetHighKey(new_internal->KeyAt(0));
+  }
+  if (new_page != nullptr) {
+    *new_page = page;
+  }
+  return reinterpret_cast<N *>(page->GetData());
 }
 
 /*
@@ -103,7 +221,174 @@ N *BPLUSTREE_TYPE::Split(N *node) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                                      Transaction *transaction) {}
+                                      Transaction *transaction) {
+  if (old_node->IsRootPage()) {
+    // the old root was unsafe, so root_latch_ is still held
+    page_id_t root_page_id;
+    Page *page = buffer_pool_manager_->NewPage(&root_page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+    }
+    auto *root = reinterpret_cast<InternalPage *>(page->GetData());
+    root->Init(root_page_id, INVALID_PAGE_ID, internal_max_size_);
+    root->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
+    old_node->SetParentPageId(root_page_id);
+    new_node->SetParentPageId(root_page_id);
+    root_page_id_ = root_page_id;
+    UpdateRootPageId(0);
+    buffer_pool_manager_->UnpinPage(root_page_id, true);
+    return;
+  }
+
+  // old_node was unsafe, so its parent is still write latched in the page set
+  Page *parent_page = FetchPage(old_node->GetParentPageId());
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  parent->InsertNodeAfter(old_node->GetPageId(), key, new_node->GetPageId());
+  if (parent->GetSize() > parent->GetMaxSize()) {
+    InternalPage *new_parent = Split(parent);
+    InsertIntoParent(parent, new_parent->KeyAt(0), new_parent, transaction);
+    buffer_pool_manager_->UnpinPage(new_parent->GetPageId(), true);
+  }
+  buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+}
+
+/*****************************************************************************
+ * BULK LOADING
+ *****************************************************************************/
+/*
+ * Build the tree from a batch of key-value pairs. If the tree is empty, the
+ * pairs are sorted and the tree is laid out bottom-up: leaves and internal
+ * pages are filled left to right to fill_factor of their capacity, and every
+ * page is written exactly once. Otherwise every pair goes through Insert.
+ * Only the first pair of each key is kept.
+ * @return: true if all pairs were inserted, false otherwise
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::BulkLoad(const std::vector<MappingType> &items, double fill_factor, Transaction *transaction) {
+  std::vector<MappingType> sorted(items);
+  auto less = [this](const MappingType &a, const MappingType &b) { return comparator_(a.first, b.first) < 0; };
+  if (!std::is_sorted(sorted.begin(), sorted.end(), less)) {
+    std::stable_sort(sorted.begin(), sorted.end(), less);
+  }
+  auto last = std::unique(sorted.begin(), sorted.end(), [this](const MappingType &a, const MappingType &b) {
+    return comparator_(a.first, b.first) == 0;
+  });
+  bool all_inserted = last == sorted.end();
+  sorted.erase(last, sorted.end());
+
+  root_latch_.WLock();
+  if (!IsEmpty()) {
+    root_latch_.WUnlock();
+    for (const auto &item : sorted) {
+      all_inserted = Insert(item.first, item.second, transaction) && all_inserted;
+    }
+    return all_inserted;
+  }
+  if (!sorted.empty()) {
+    // the new pages become reachable only once the root is published
+    root_page_id_ = BulkBuild(sorted, fill_factor);
+    UpdateRootPageId(1);
+  }
+  root_latch_.WUnlock();
+  return all_inserted;
+}
+
+/*
+ * The shape of every level is fixed before any page is written: each level
+ * gets as many pages as the fill factor asks for, but never so many that a
+ * page would fall below its minimum size, and the entries are spread evenly
+ * over them. The pairs then stream through one open page per level.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::BulkBuild(const std::vector<MappingType> &items, double fill_factor) {
+  // a leaf splits when it reaches max size, an internal page when it exceeds it
+  const int leaf_capacity = leaf_max_size_ - 1;
+  const int internal_capacity = internal_max_size_;
+  auto num_pages = [fill_factor](int num_entries, int capacity, int min_size) {
+    int target = std::clamp(static_cast<int>(fill_factor * capacity), std::max(min_size, 1), capacity);
+    return std::max(1, std::min((num_entries + target - 1) / target, num_entries / std::max(min_size, 1)));
+  };
+
+  std::vector<BulkLevel> levels;
+  int num_entries = static_cast<int>(items.size());
+  levels.push_back({num_pages(num_entries, leaf_capacity, leaf_max_size_ / 2), num_entries});
+  while (levels.back().num_pages > 1) {
+    num_entries = levels.back().num_pages;
+    levels.push_back({num_pages(num_entries, internal_capacity, (internal_max_size_ + 1) / 2), num_entries});
+  }
+
+  for (const auto &item : items) {
+    BulkAppend(&levels, 0, item.first, &item, INVALID_PAGE_ID);
+  }
+  page_id_t root_page_id = levels.back().page->GetPageId();
+  for (size_t level = 0; level < levels.size(); level++) {
+    BulkClosePage(&levels, level);
+  }
+  return root_page_id;
+}
+
+/*
+ * A full page is replaced by a new page to its right before the entry is
+ * appended, which is when its right link and high key become known.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::BulkAppend(std::vector<BulkLevel> *levels, size_t level, const KeyType &key,
+                                const MappingType *item, page_id_t child_page_id) {
+  BulkLevel &current = (*levels)[level];
+  auto *node = current.page == nullptr ? nullptr : reinterpret_cast<BPlusTreePage *>(current.page->GetData());
+  if (node == nullptr || node->GetSize() == current.PageSize()) {
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+    }
+    if (level == 0) {
+      auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+      leaf->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+      if (node != nullptr) {
+        leaf->SetPrevPageId(node->GetPageId());
+      }
+    } else {
+      reinterpret_cast<InternalPage *>(page->GetData())->Init(page_id, INVALID_PAGE_ID, internal_max_size_);
+    }
+    if (node != nullptr) {
+      if (level == 0) {
+        reinterpret_cast<LeafPage *>(node)->SetNextPageId(page_id);
+        reinterpret_cast<LeafPage *>(node)->SetHighKey(key);
+      } else {
+        reinterpret_cast<InternalPage *>(node)->SetNextPageId(page_id);
+        reinterpret_cast<InternalPage *>(node)->SetHighKey(key);
+      }
+      BulkClosePage(levels, level);
+      current.page_index++;
+    }
+    current.page = page;
+    current.low_key = key;
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  }
+
+  if (level == 0) {
+    reinterpret_cast<LeafPage *>(node)->CopyLastFrom(*item);
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    internal->SetKeyAt(internal->GetSize(), key);
+    internal->SetValueAt(internal->GetSize(), child_page_id);
+    internal->IncreaseSize(1);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::BulkClosePage(std::vector<BulkLevel> *levels, size_t level) {
+  BulkLevel &current = (*levels)[level];
+  auto *node = reinterpret_cast<BPlusTreePage *>(current.page->GetData());
+  // the topmost level holds only the root, which has no parent
+  if (level + 1 < levels->size()) {
+    BulkAppend(levels, level + 1, current.low_key, nullptr, node->GetPageId());
+    node->SetParentPageId((*levels)[level + 1].page->GetPageId());
+  }
+  buffer_pool_manager_->UnpinPage(node->GetPageId(), true);
+  current.page = nullptr;
+}
 
 /*****************************************************************************
  * REMOVE
@@ -116,19 +401,89 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
  * necessary.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
+void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  if (protocol_ == BPlusTreeProtocol::B_LINK) {
+    RemoveBLink(key);
+    return;
+  }
+  if (transaction == nullptr) {
+    Transaction txn(INVALID_TXN_ID);
+    Remove(key, &txn);
+    return;
+  }
+
+  // fast path: only the leaf is write latched, which is enough as long as it does not underflow
+  Page *leaf_page = FindLeafPageOptimistic(key, false, Operation::DELETE);
+  if (leaf_page == nullptr) {
+    return;
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  ValueType value;
+  bool found = leaf->Lookup(key, &value, comparator_);
+  bool safe = !found || IsSafe(leaf, Operation::DELETE);
+  if (found && safe) {
+    leaf->RemoveAndDeleteRecord(key, comparator_);
+  }
+  leaf_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), found && safe);
+  if (safe) {
+    return;
+  }
+
+  root_latch_.WLock();
+  transaction->AddIntoPageSet(nullptr);
+  if (IsEmpty()) {
+    ReleaseLatches(transaction, false);
+    return;
+  }
+  leaf_page = FindLeafPagePessimistic(key, Operation::DELETE, transaction);
+  leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  int size = leaf->GetSize();
+  if (leaf->RemoveAndDeleteRecord(key, comparator_) < size && CoalesceOrRedistribute(leaf, transaction)) {
+    transaction->AddIntoDeletedPageSet(leaf->GetPageId());
+  }
+  ReleaseLatches(transaction, true);
+}
 
 /*
  * User needs to first find the sibling of input page. If sibling's size + input
  * page's size > page's max size, then redistribute. Otherwise, merge.
  * Using template N to represent either internal page or leaf page.
+ * The sibling is write latched here; the parent already is, since node is unsafe.
  * @return: true means target leaf page should be deleted, false means no
  * deletion happens
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 bool BPLUSTREE_TYPE::CoalesceOrRedistribute(N *node, Transaction *transaction) {
-  return false;
+  if (node->IsRootPage()) {
+    return AdjustRoot(node);
+  }
+  if (node->GetSize() >= node->GetMinSize()) {
+    return false;
+  }
+
+  Page *parent_page = FetchPage(node->GetParentPageId());
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  int index = parent->ValueIndex(node->GetPageId());
+  // the first child pairs with its right sibling, every other child with its left one
+  page_id_t sibling_page_id = parent->ValueAt(index == 0 ? 1 : index - 1);
+  Page *sibling_page = FetchPage(sibling_page_id);
+  sibling_page->WLatch();
+  auto *sibling = reinterpret_cast<N *>(sibling_page->GetData());
+
+  bool node_deleted = false;
+  int total = sibling->GetSize() + node->GetSize();
+  bool fits = node->IsLeafPage() ? total < node->GetMaxSize() : total <= node->GetMaxSize();
+  if (fits) {
+    node_deleted = Coalesce(&sibling, &node, &parent, index, transaction);
+  } else {
+    Redistribute(sibling, node, index);
+  }
+  sibling_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(sibling_page_id, true);
+  buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+  return node_deleted;
 }
 
 /*
@@ -137,10 +492,12 @@ bool BPLUSTREE_TYPE::CoalesceOrRedistribute(N *node, Transaction *transaction) {
  * take info of deletion into account. Remember to deal with coalesce or
  * redistribute recursively if necessary.
  * Using template N to represent either internal page or leaf page.
+ * The right page of the pair is always merged into the left one. If that is the
+ * sibling, it is recorded in the deleted page set here.
  * @param   neighbor_node      sibling page of input "node"
  * @param   node               input from method coalesceOrRedistribute()
  * @param   parent             parent page of input "node"
- * @return  true means parent node should be deleted, false means no deletion
+ * @return  true means "node" should be deleted, false means no deletion
  * happend
  */
 INDEX_TEMPLATE_ARGUMENTS
@@ -148,7 +505,29 @@ template <typename N>
 bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
                               BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> **parent, int index,
                               Transaction *transaction) {
-  return false;
+  bool node_is_right = index != 0;
+  N *left = node_is_right ? *neighbor_node : *node;
+  N *right = node_is_right ? *node : *neighbor_node;
+  int right_index = node_is_right ? index : 1;
+
+  if (right->IsLeafPage()) {
+    reinterpret_cast<LeafPage *>(right)->MoveAllTo(reinterpret_cast<LeafPage *>(left));
+    page_id_t next_page_id = reinterpret_cast<LeafPage *>(left)->GetNextPageId();
+    if (next_page_id != INVALID_PAGE_ID) {
+      SetPrevLink(next_page_id, left->GetPageId());
+    }
+  } else {
+    reinterpret_cast<InternalPage *>(right)->MoveAllTo(reinterpret_cast<InternalPage *>(left),
+                                                       (*parent)->KeyAt(right_index), buffer_pool_manager_);
+  }
+  (*parent)->Remove(right_index);
+  if (!node_is_right) {
+    transaction->AddIntoDeletedPageSet(right->GetPageId());
+  }
+  if (CoalesceOrRedistribute(*parent, transaction)) {
+    transaction->AddIntoDeletedPageSet((*parent)->GetPageId());
+  }
+  return node_is_right;
 }
 
 /*
@@ -162,7 +541,37 @@ bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
-void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
+void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {
+  Page *parent_page = FetchPage(node->GetParentPageId());
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  // the separator between the two pages moves, and with it the high key of the left one
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *neighbor = reinterpret_cast<LeafPage *>(neighbor_node);
+    if (index == 0) {
+      neighbor->MoveFirstToEndOf(leaf);
+      parent->SetKeyAt(1, neighbor->KeyAt(0));
+      leaf->SetHighKey(neighbor->KeyAt(0));
+    } else {
+      neighbor->MoveLastToFrontOf(leaf);
+      parent->SetKeyAt(index, leaf->KeyAt(0));
+      neighbor->SetHighKey(leaf->KeyAt(0));
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *neighbor = reinterpret_cast<InternalPage *>(neighbor_node);
+    if (index == 0) {
+      neighbor->MoveFirstToEndOf(internal, parent->KeyAt(1), buffer_pool_manager_);
+      parent->SetKeyAt(1, neighbor->KeyAt(0));
+      internal->SetHighKey(neighbor->KeyAt(0));
+    } else {
+      neighbor->MoveLastToFrontOf(internal, parent->KeyAt(index), buffer_pool_manager_);
+      parent->SetKeyAt(index, internal->KeyAt(0));
+      neighbor->SetHighKey(internal->KeyAt(0));
+    }
+  }
+  buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+}
 /*
  * Update root page if necessary
  * NOTE: size of root page can be less than min size and this method is only
@@ -174,7 +583,259 @@ void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
  * happend
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
+bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) {
+  if (!old_root_node->IsLeafPage() && old_root_node->GetSize() == 1) {
+    root_page_id_ = reinterpret_cast<InternalPage *>(old_root_node)->RemoveAndReturnOnlyChild();
+    Page *page = FetchPage(root_page_id_);
+    reinterpret_cast<BPlusTreePage *>(page->GetData())->SetParentPageId(INVALID_PAGE_ID);
+    buffer_pool_manager_->UnpinPage(root_page_id_, true);
+    UpdateRootPageId(0);
+    return true;
+  }
+  if (old_root_node->IsLeafPage() && old_root_node->GetSize() == 0) {
+    root_page_id_ = INVALID_PAGE_ID;
+    UpdateRootPageId(0);
+    return true;
+  }
+  return false;
+}
+
+/*****************************************************************************
+ * B-LINK PROTOCOL
+ *****************************************************************************/
+/*
+ * Point lookup without latches. Each page is read against its version and read
+ * again if a writer changed it meanwhile; a key beyond the page's high key means
+ * the page split after we left its parent, so we follow the right link.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::GetValueBLink(const KeyType &key, std::vector<ValueType> *result) {
+  page_id_t page_id = root_page_id_;
+  if (page_id == INVALID_PAGE_ID) {
+    return false;
+  }
+  Page *page = FetchPage(page_id);
+  while (true) {
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    uint32_t version = node->StableVersion();
+    page_id_t next_page_id = MoveRight(node, key);
+    bool found = false;
+    ValueType value;
+    if (next_page_id == INVALID_PAGE_ID) {
+      if (node->IsLeafPage()) {
+        found = reinterpret_cast<LeafPage *>(node)->Lookup(key, &value, comparator_);
+      } else {
+        next_page_id = reinterpret_cast<InternalPage *>(node)->Lookup(key, comparator_);
+      }
+    }
+    if (!node->ValidateVersion(version)) {
+      continue;
+    }
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    if (next_page_id == INVALID_PAGE_ID) {
+      if (found) {
+        result->push_back(value);
+      }
+      return found;
+    }
+    page = FetchPage(next_page_id);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::InsertBLink(const KeyType &key, const ValueType &value) {
+  if (IsEmpty()) {
+    root_latch_.WLock();
+    if (IsEmpty()) {
+      StartNewTree(key, value);
+      root_latch_.WUnlock();
+      return true;
+    }
+    root_latch_.WUnlock();
+  }
+
+  Page *leaf_page = LatchLeafPageBLink(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  ValueType old_value;
+  if (leaf->Lookup(key, &old_value, comparator_)) {
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
+    return false;
+  }
+
+  leaf->BeginWrite();
+  leaf->Insert(key, value, comparator_);
+  Page *new_leaf_page = nullptr;
+  if (leaf->GetSize() >= leaf->GetMaxSize()) {
+    Split(leaf, &new_leaf_page);
+    // nobody can follow the right link to the new leaf before EndWrite()
+    new_leaf_page->WLatch();
+  }
+  leaf->EndWrite();
+
+  if (new_leaf_page == nullptr) {
+    leaf_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
+    return true;
+  }
+  InsertIntoParentBLink(leaf_page, reinterpret_cast<LeafPage *>(new_leaf_page->GetData())->KeyAt(0), new_leaf_page);
+  buffer_pool_manager_->UnpinPage(new_leaf_page->GetPageId(), true);
+  return true;
+}
+
+/*
+ * Add the separator for new_page, the right half of the split old_page, to the
+ * parent. Both pages are write latched (and released here, new_page stays
+ * pinned). Others can reach new_page through the right link of old_page without
+ * any latch, so new_page stays latched until the parent is latched, or the new
+ * root is in place: nobody can split new_page and go looking for its parent
+ * before its entry is there. The recorded parent may have split in the
+ * meantime, in which case the entry for old_page has moved to one of its right
+ * siblings.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertIntoParentBLink(Page *old_page, const KeyType &key, Page *new_page) {
+  auto *old_node = reinterpret_cast<BPlusTreePage *>(old_page->GetData());
+  auto *new_node = reinterpret_cast<BPlusTreePage *>(new_page->GetData());
+  if (old_node->IsRootPage()) {
+    root_latch_.WLock();
+    page_id_t root_page_id;
+    Page *page = buffer_pool_manager_->NewPage(&root_page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+    }
+    auto *root = reinterpret_cast<InternalPage *>(page->GetData());
+    root->Init(root_page_id, INVALID_PAGE_ID, internal_max_size_);
+    root->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
+    old_node->SetParentPageId(root_page_id);
+    new_node->SetParentPageId(root_page_id);
+    root_page_id_ = root_page_id;
+    UpdateRootPageId(0);
+    buffer_pool_manager_->UnpinPage(root_page_id, true);
+    root_latch_.WUnlock();
+    new_page->WUnlatch();
+    old_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(old_page->GetPageId(), true);
+    return;
+  }
+
+  Page *parent_page = FetchPage(old_node->GetParentPageId());
+  parent_page->WLatch();
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  while (parent->ValueIndex(old_page->GetPageId()) == -1) {
+    Page *right_page = FetchPage(parent->GetNextPageId());
+    right_page->WLatch();
+    parent_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), false);
+    parent_page = right_page;
+    parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  }
+  // old_page may be evicted once unpinned
+  page_id_t old_page_id = old_page->GetPageId();
+  new_node->SetParentPageId(parent_page->GetPageId());
+  new_page->WUnlatch();
+  old_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(old_page_id, true);
+
+  parent->BeginWrite();
+  parent->InsertNodeAfter(old_page_id, key, new_node->GetPageId());
+  Page *new_parent_page = nullptr;
+  if (parent->GetSize() > parent->GetMaxSize()) {
+    Split(parent, &new_parent_page);
+    new_parent_page->WLatch();
+  }
+  parent->EndWrite();
+
+  if (new_parent_page == nullptr) {
+    parent_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+    return;
+  }
+  InsertIntoParentBLink(parent_page, reinterpret_cast<InternalPage *>(new_parent_page->GetData())->KeyAt(0),
+                        new_parent_page);
+  buffer_pool_manager_->UnpinPage(new_parent_page->GetPageId(), true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemoveBLink(const KeyType &key) {
+  if (IsEmpty()) {
+    return;
+  }
+  Page *leaf_page = LatchLeafPageBLink(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  int size = leaf->GetSize();
+  leaf->BeginWrite();
+  bool removed = leaf->RemoveAndDeleteRecord(key, comparator_) < size;
+  leaf->EndWrite();
+  leaf_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), removed);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageBLink(const KeyType &key, bool left_most, bool right_most) {
+  page_id_t page_id = root_page_id_;
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  Page *page = FetchPage(page_id);
+  while (true) {
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    uint32_t version = node->StableVersion();
+    page_id_t next_page_id =
+        left_most ? INVALID_PAGE_ID : right_most ? RightSibling(node) : MoveRight(node, key);
+    if (next_page_id == INVALID_PAGE_ID && !node->IsLeafPage()) {
+      auto *internal = reinterpret_cast<InternalPage *>(node);
+      if (left_most) {
+        next_page_id = internal->ValueAt(0);
+      } else {
+        next_page_id = right_most ? internal->ValueAt(internal->GetSize() - 1) : internal->Lookup(key, comparator_);
+      }
+    }
+    if (!node->ValidateVersion(version)) {
+      continue;
+    }
+    if (next_page_id == INVALID_PAGE_ID) {
+      return page;
+    }
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = FetchPage(next_page_id);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::LatchLeafPageBLink(const KeyType &key) {
+  Page *page = FindLeafPageBLink(key, false);
+  page->WLatch();
+  page_id_t next_page_id;
+  while ((next_page_id = MoveRight(reinterpret_cast<BPlusTreePage *>(page->GetData()), key)) != INVALID_PAGE_ID) {
+    Page *right_page = FetchPage(next_page_id);
+    right_page->WLatch();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = right_page;
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::MoveRight(BPlusTreePage *node, const KeyType &key) const {
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    page_id_t next_page_id = leaf->GetNextPageId();
+    return next_page_id != INVALID_PAGE_ID && comparator_(key, leaf->GetHighKey()) >= 0 ? next_page_id
+                                                                                          : INVALID_PAGE_ID;
+  }
+  auto *internal = reinterpret_cast<InternalPage *>(node);
+  page_id_t next_page_id = internal->GetNextPageId();
+  return next_page_id != INVALID_PAGE_ID && comparator_(key, internal->GetHighKey()) >= 0 ? next_page_id
+                                                                                            : INVALID_PAGE_ID;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::RightSibling(BPlusTreePage *node) const {
+  return node->IsLeafPage() ? reinterpret_cast<LeafPage *>(node)->GetNextPageId()
+                            : reinterpret_cast<InternalPage *>(node)->GetNextPageId();
+}
 
 /*****************************************************************************
  * INDEX ITERATOR
@@ -185,7 +846,7 @@ bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() { return Begin(std::nullopt, std::nullopt); }
 
 /*
  * Input parameter is low key, find the leaf page that contains the input key
@@ -193,7 +854,32 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() { return INDEXITERATOR_TYPE(); }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) { return Begin(key, std::nullopt); }
+
+/*
+ * Range scan: start from the leaf holding the bound the scan starts at (or the
+ * leftmost/rightmost leaf if that bound is open); the iterator stops at the
+ * other bound without reading the leaves past it.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const std::optional<KeyType> &low, const std::optional<KeyType> &high,
+                                         bool reverse, int read_ahead) {
+  const std::optional<KeyType> &start = reverse ? high : low;
+  Page *leaf_page = start.has_value() ? FindLeafPageRead(*start, false)
+                                      : FindLeafPageRead(KeyType{}, !reverse, reverse);
+  if (leaf_page == nullptr) {
+    return INDEXITERATOR_TYPE();
+  }
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, leaf_page, &comparator_, low, high, reverse, read_ahead);
+}
+
+/*
+ * Input parameter is void, find the rightmost leaf page first, then construct
+ * an index iterator going backwards
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::RBegin() { return Begin(std::nullopt, std::nullopt, true); }
 
 /*
  * Input parameter is void, construct an index iterator representing the end
@@ -212,12 +898,181 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() { return INDEXITERATOR_TYPE(); }
  */
 INDEX_TEMPLATE_ARGUMENTS
 Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
-  throw Exception(ExceptionType::NOT_IMPLEMENTED, "Implement this for test");
+  if (protocol_ == BPlusTreeProtocol::B_LINK) {
+    return FindLeafPageBLink(key, leftMost);
+  }
+  Page *page = FindLeafPageOptimistic(key, leftMost, Operation::READ);
+  if (page != nullptr) {
+    page->RUnlatch();
+  }
+  return page;
 }
 
 /*
- * Update/Insert root page id in header page(where page_id = 0, header_page is
- * defined under include/page/header_page.h)
+ * Find the leaf a scan starts from and return it pinned and read latched.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageRead(const KeyType &key, bool left_most, bool right_most) {
+  if (protocol_ == BPlusTreeProtocol::B_LINK) {
+    // pages are never freed under this protocol, so latching the leaf after the descent is safe;
+    // if it splits in between, move right under the latch: a descending scan starts from the
+    // leaf and would miss the right half
+    Page *page = FindLeafPageBLink(key, left_most, right_most);
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->RLatch();
+    while (true) {
+      auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+      page_id_t next_page_id = right_most ? RightSibling(node) : MoveRight(node, key);
+      if (left_most || next_page_id == INVALID_PAGE_ID) {
+        return page;
+      }
+      Page *right_page = FetchPage(next_page_id);
+      right_page->RLatch();
+      page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      page = right_page;
+    }
+  }
+  return FindLeafPageOptimistic(key, left_most, Operation::READ, right_most);
+}
+
+/*
+ * Descend from the root with read latches, releasing each parent as soon as the
+ * child is latched. The leaf is write latched unless op is READ; a page cannot
+ * turn from leaf into internal page while its parent (or root_latch_ for the
+ * root) is latched, so checking the type before latching is safe.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageOptimistic(const KeyType &key, bool left_most, Operation op, bool right_most) {
+  root_latch_.RLock();
+  if (IsEmpty()) {
+    root_latch_.RUnlock();
+    return nullptr;
+  }
+  Page *page = FetchPage(root_page_id_);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (node->IsLeafPage() && op != Operation::READ) {
+    page->WLatch();
+  } else {
+    page->RLatch();
+  }
+  root_latch_.RUnlock();
+
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_page_id;
+    if (left_most) {
+      child_page_id = internal->ValueAt(0);
+    } else {
+      child_page_id = right_most ? internal->ValueAt(internal->GetSize() - 1) : internal->Lookup(key, comparator_);
+    }
+    Page *child_page = FetchPage(child_page_id);
+    auto *child = reinterpret_cast<BPlusTreePage *>(child_page->GetData());
+    if (child->IsLeafPage() && op != Operation::READ) {
+      child_page->WLatch();
+    } else {
+      child_page->RLatch();
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = child_page;
+    node = child;
+  }
+  return page;
+}
+
+/*
+ * Descend from the root with write latches. Every latched page goes into the
+ * page set; once a page is safe for op, the latches above it are released.
+ * Returns the leaf, which is the last page in the page set.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPagePessimistic(const KeyType &key, Operation op, Transaction *transaction) {
+  Page *page = FetchPage(root_page_id_);
+  page->WLatch();
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (IsSafe(node, op)) {
+    ReleaseLatches(transaction, false);
+  }
+  transaction->AddIntoPageSet(page);
+
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page = FetchPage(internal->Lookup(key, comparator_));
+    page->WLatch();
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (IsSafe(node, op)) {
+      ReleaseLatches(transaction, false);
+    }
+    transaction->AddIntoPageSet(page);
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::IsSafe(BPlusTreePage *node, Operation op) const {
+  switch (op) {
+    case Operation::READ:
+      return true;
+    case Operation::INSERT:
+      // a leaf splits when it reaches max size, an internal page when it exceeds it
+      return node->IsLeafPage() ? node->GetSize() + 1 < node->GetMaxSize() : node->GetSize() < node->GetMaxSize();
+    case Operation::DELETE:
+      if (node->IsRootPage()) {
+        return node->GetSize() > (node->IsLeafPage() ? 1 : 2);
+      }
+      return node->GetSize() > node->GetMinSize();
+  }
+  return false;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseLatches(Transaction *transaction, bool is_dirty) {
+  auto page_set = transaction->GetPageSet();
+  while (!page_set->empty()) {
+    Page *page = page_set->front();
+    page_set->pop_front();
+    if (page == nullptr) {
+      root_latch_.WUnlock();
+    } else {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), is_dirty);
+    }
+  }
+  auto deleted_page_set = transaction->GetDeletedPageSet();
+  for (page_id_t page_id : *deleted_page_set) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  deleted_page_set->clear();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FetchPage(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch page");
+  }
+  return page;
+}
+
+/*
+ * Point the back link of leaf page_id at prev_page_id. Callers hold the latch
+ * of the leaf to its left, so latching this one keeps latches left to right.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetPrevLink(page_id_t page_id, page_id_t prev_page_id) {
+  Page *page = FetchPage(page_id);
+  page->WLatch();
+  reinterpret_cast<LeafPage *>(page->GetData())->SetPrevPageId(prev_page_id);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+/*
+ * Update/Insert root page id in header page(header_page_id_, page 0 unless the
+ * tree was given its own; header_page is defined under include/page/header_page.h)
  * Call this method everytime root page id is changed.
  * @parameter: insert_record      defualt value is false. When set to true,
  * insert a record <index_name, root_page_id> into header page instead of
@@ -225,15 +1080,14 @@ Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
-  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
-  if (insert_record != 0) {
-    // create a new record<index_name + root_page_id> in header_page
-    header_page->InsertRecord(index_name_, root_page_id_);
-  } else {
+  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id_));
+  // create a new record<index_name + root_page_id> in header_page, or update it if the tree
+  // was emptied and started over
+  if (insert_record == 0 || !header_page->InsertRecord(index_name_, root_page_id_)) {
     // update root_page_id in header_page
     header_page->UpdateRecord(index_name_, root_page_id_);
   }
-  buffer_pool_manager_->UnpinPage(HEADER_PAGE_ID, true);
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
 }
 
 /*
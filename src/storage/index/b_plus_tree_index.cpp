@@ -11,21 +11,41 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include "common/exception.h"
+
 namespace bustub {
 /*
  * Constructor
  */
 INDEX_TEMPLATE_ARGUMENTS
-BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
+BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                                     BPlusTreeProtocol protocol, page_id_t header_page_id, bool unique)
     : Index(std::move(metadata)),
+      unique_(unique),
       comparator_(GetMetadata()->GetKeySchema()),
-      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_) {}
+      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, LEAF_PAGE_SIZE, INTERNAL_PAGE_SIZE,
+                 protocol, header_page_id) {
+  if (!unique_ && sizeof(KeyType) <= RID_SUFFIX_SIZE) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "key is too short for a non-unique index");
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::MakeKey(const Tuple &key, const RID &rid, KeyType *index_key) const {
+  if constexpr (sizeof(KeyType) > RID_SUFFIX_SIZE) {
+    if (!unique_) {
+      index_key->SetFromKey(key, GetKeySchema(), rid);
+      return;
+    }
+  }
+  index_key->SetFromKey(key, GetKeySchema());
+}
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  MakeKey(key, rid, &index_key);
 
   container_.Insert(index_key, rid, transaction);
 }
@@ -34,18 +54,43 @@ INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  MakeKey(key, rid, &index_key);
 
   container_.Remove(index_key, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
-  // construct scan index key
-  KeyType index_key;
-  index_key.SetFromKey(key);
+  if (unique_) {
+    // construct scan index key
+    KeyType index_key;
+    MakeKey(key, RID(), &index_key);
+
+    container_.GetValue(index_key, result, transaction);
+    return;
+  }
 
-  container_.GetValue(index_key, result, transaction);
+  // every RID of the key, from one descent and a walk over the leaves that hold them
+  KeyType low;
+  KeyType high;
+  MakeKey(key, RID_SUFFIX_MIN, &low);
+  MakeKey(key, RID_SUFFIX_MAX, &high);
+  for (auto iterator = container_.Begin(low, high); !iterator.IsEnd(); ++iterator) {
+    result->push_back((*iterator).second);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::BulkInsertEntries(const std::vector<std::pair<Tuple, RID>> &entries,
+                                             Transaction *transaction) {
+  // construct all index keys up front
+  std::vector<MappingType> items(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    MakeKey(entries[i].first, entries[i].second, &items[i].first);
+    items[i].second = entries[i].second;
+  }
+
+  container_.BulkLoad(items, BULK_LOAD_FILL_FACTOR, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -54,6 +99,21 @@ INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator() { return container_.
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) { return container_.Begin(key); }
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetRangeIterator(const Tuple *low_key, const Tuple *high_key, bool reverse,
+                                                          int read_ahead) {
+  // construct the bounds that are given
+  std::optional<KeyType> low;
+  std::optional<KeyType> high;
+  if (low_key != nullptr) {
+    MakeKey(*low_key, RID_SUFFIX_MIN, &low.emplace());
+  }
+  if (high_key != nullptr) {
+    MakeKey(*high_key, RID_SUFFIX_MAX, &high.emplace());
+  }
+  return container_.Begin(low, high, reverse, read_ahead);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetEndIterator() { return container_.End(); }
 
@@ -1,30 +1,191 @@
 /**
  * index_iterator.cpp
  */
+#include <algorithm>
 #include <cassert>
+#include <chrono>  // NOLINT
 
+#include "common/exception.h"
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
 
-/*
- * NOTE: you can change the destructor/constructor method here
- * set your own input parameters
- */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator() = default;
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(BufferPoolManager *buffer_pool_manager, Page *leaf_page,
+                                  const KeyComparator *comparator, std::optional<KeyType> low,
+                                  std::optional<KeyType> high, bool reverse, int read_ahead)
+    : buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      low_(std::move(low)),
+      high_(std::move(high)),
+      reverse_(reverse),
+      read_ahead_(read_ahead) {
+  CopyLeaf(leaf_page);
+  ReadAhead();
+  if (items_.empty()) {
+    LoadNextLeaf();
+  }
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::~IndexIterator() = default;
 
 INDEX_TEMPLATE_ARGUMENTS
-bool INDEXITERATOR_TYPE::IsEnd() { throw std::runtime_error("unimplemented"); }
+bool INDEXITERATOR_TYPE::IsEnd() { return page_id_ == INVALID_PAGE_ID; }
+
+INDEX_TEMPLATE_ARGUMENTS
+const MappingType &INDEXITERATOR_TYPE::operator*() { return items_[index_]; }
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
+  if (++index_ >= items_.size()) {
+    LoadNextLeaf();
+  }
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::CopyLeaf(Page *leaf_page) {
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  page_id_ = leaf_page->GetPageId();
+  next_page_id_ = INVALID_PAGE_ID;
+  items_.clear();
+  // a page freed by a concurrent merge may have been reused for something else
+  if (leaf->IsLeafPage()) {
+    int first = low_.has_value() ? leaf->KeyIndex(*low_, *comparator_) : 0;
+    int last = high_.has_value() ? leaf->UpperKeyIndex(*high_, *comparator_) : leaf->GetSize();
+    for (int i = first; i < last; i++) {
+      items_.push_back(leaf->GetItem(i));
+    }
+    // the scan goes on unless this leaf already holds keys beyond the bound it is heading for
+    if (reverse_) {
+      std::reverse(items_.begin(), items_.end());
+      if (first == 0) {
+        next_page_id_ = leaf->GetPrevPageId();
+      }
+    } else if (last == leaf->GetSize()) {
+      next_page_id_ = leaf->GetNextPageId();
+    }
+  }
+  leaf_page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id_, false);
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-const MappingType &INDEXITERATOR_TYPE::operator*() { throw std::runtime_error("unimplemented"); }
+void INDEXITERATOR_TYPE::LoadNextLeaf() {
+  index_ = 0;
+  while (next_page_id_ != INVALID_PAGE_ID) {
+    CopyLeaf(reverse_ ? FetchPrevLeaf() : FetchLeaf(next_page_id_));
+    leaves_ahead_--;
+    ReadAhead();
+    if (!items_.empty()) {
+      return;
+    }
+  }
+  items_.clear();
+  page_id_ = INVALID_PAGE_ID;
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() { throw std::runtime_error("unimplemented"); }
+Page *INDEXITERATOR_TYPE::FetchLeaf(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch leaf page");
+  }
+  page->RLatch();
+  return page;
+}
+
+/*
+ * The prev page id of the leaf the scan just left is only a hint: the leaf it
+ * names may have split since, putting its right half in between. Move right
+ * from it, latching left to right like writers do, until the leaf that links
+ * to the one just left, but only across leaves whose keys all come before the
+ * pairs the scan has returned already.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *INDEXITERATOR_TYPE::FetchPrevLeaf() {
+  Page *page = FetchLeaf(next_page_id_);
+  if (items_.empty()) {
+    return page;
+  }
+  const KeyType &boundary = items_.back().first;
+  while (true) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    if (!leaf->IsLeafPage() || leaf->GetNextPageId() == page_id_ || leaf->GetNextPageId() == INVALID_PAGE_ID) {
+      return page;
+    }
+    Page *right_page = FetchLeaf(leaf->GetNextPageId());
+    auto *right = reinterpret_cast<LeafPage *>(right_page->GetData());
+    if (!right->IsLeafPage() || right->GetSize() == 0 || (*comparator_)(right->KeyAt(0), boundary) >= 0) {
+      right_page->RUnlatch();
+      buffer_pool_manager_->UnpinPage(right_page->GetPageId(), false);
+      return page;
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = right_page;
+  }
+}
+
+/*
+ * Start fetching the next leaves in the background once the previous batch is
+ * done and the scan is at least halfway through it. The task only touches the
+ * buffer pool, one leaf at a time under its read latch, and knows nothing of
+ * the iterator, which may move in the meantime; the iterator waits for it when
+ * destroyed.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::ReadAhead() {
+  if (read_ahead_ == 0) {
+    return;
+  }
+  if (read_ahead_task_.valid()) {
+    if (read_ahead_task_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return;
+    }
+    read_ahead_page_id_ = read_ahead_task_.get();
+  }
+  if (leaves_ahead_ <= 0) {
+    // the scan caught up with the read ahead
+    leaves_ahead_ = 0;
+    read_ahead_page_id_ = next_page_id_;
+  }
+  if (read_ahead_page_id_ == INVALID_PAGE_ID || leaves_ahead_ > read_ahead_ / 2) {
+    return;
+  }
+
+  auto fetch_leaves = [bpm = buffer_pool_manager_, comparator = comparator_, low = low_, high = high_,
+                       reverse = reverse_](page_id_t page_id, int count) {
+    for (; count > 0 && page_id != INVALID_PAGE_ID; count--) {
+      Page *page = bpm->FetchPage(page_id);
+      if (page == nullptr) {
+        return INVALID_PAGE_ID;
+      }
+      page->RLatch();
+      auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+      page_id_t next_page_id = INVALID_PAGE_ID;
+      if (leaf->IsLeafPage()) {
+        int size = leaf->GetSize();
+        if (reverse && (!low.has_value() || size == 0 || (*comparator)(leaf->KeyAt(0), *low) >= 0)) {
+          next_page_id = leaf->GetPrevPageId();
+        } else if (!reverse && (!high.has_value() || size == 0 || (*comparator)(leaf->KeyAt(size - 1), *high) <= 0)) {
+          next_page_id = leaf->GetNextPageId();
+        }
+      }
+      page->RUnlatch();
+      bpm->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+    return page_id;
+  };
+  int count = read_ahead_ - leaves_ahead_;
+  leaves_ahead_ = read_ahead_;
+  read_ahead_task_ = std::async(std::launch::async, fetch_leaves, read_ahead_page_id_, count);
+}
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
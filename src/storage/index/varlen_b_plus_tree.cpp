@@ -0,0 +1,403 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree.cpp
+//
+// Identification: src/storage/index/varlen_b_plus_tree.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/index/varlen_b_plus_tree.h"
+#include "storage/page/header_page.h"
+
+namespace bustub {
+
+VarlenBPlusTree::VarlenBPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, page_id_t header_page_id)
+    : index_name_(std::move(name)),
+      root_page_id_(INVALID_PAGE_ID),
+      buffer_pool_manager_(buffer_pool_manager),
+      header_page_id_(header_page_id) {}
+
+bool VarlenBPlusTree::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * Return the only value that associated with input key
+ * @return : true means key exists
+ */
+bool VarlenBPlusTree::GetValue(std::string_view key, std::vector<RID> *result, Transaction *transaction) {
+  latch_.RLock();
+  if (IsEmpty()) {
+    latch_.RUnlock();
+    return false;
+  }
+  Path path;
+  FindLeaf(key, &path);
+  auto *leaf = reinterpret_cast<LeafPage *>(path.pages.back()->GetData());
+  int index = leaf->LowerBound(key);
+  bool found = index < leaf->GetSize() && leaf->KeyAt(index) == key;
+  if (found) {
+    result->push_back(leaf->ValueAt(index));
+  }
+  UnpinPath(path, false);
+  latch_.RUnlock();
+  return found;
+}
+
+void VarlenBPlusTree::FindLeaf(std::string_view key, Path *path) {
+  page_id_t page_id = root_page_id_;
+  while (true) {
+    Page *page = FetchPage(page_id);
+    path->pages.push_back(page);
+    if (reinterpret_cast<BPlusTreePage *>(page->GetData())->IsLeafPage()) {
+      return;
+    }
+    auto *internal = reinterpret_cast<InternalPage *>(page->GetData());
+    int index = internal->ChildIndex(key);
+    path->child_indexes.push_back(index);
+    page_id = internal->ValueAt(index);
+  }
+}
+
+void VarlenBPlusTree::UnpinPath(const Path &path, bool is_dirty) {
+  for (Page *page : path.pages) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), is_dirty);
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * Insert constant key & value pair into b+ tree
+ * if current tree is empty, start new tree, otherwise insert into leaf page,
+ * splitting it by bytes if the key does not fit.
+ * @return: since we only support unique key, if user try to insert duplicate
+ * keys return false, otherwise return true.
+ */
+bool VarlenBPlusTree::Insert(std::string_view key, const RID &value, Transaction *transaction) {
+  if (key.size() > VARLEN_KEY_MAX_SIZE) {
+    return false;
+  }
+  latch_.WLock();
+  if (IsEmpty()) {
+    page_id_t page_id;
+    auto *leaf = reinterpret_cast<LeafPage *>(NewPage(&page_id)->GetData());
+    leaf->Init(page_id, IndexPageType::LEAF_PAGE, "", nullptr);
+    leaf->Insert(0, key, value);
+    root_page_id_ = page_id;
+    UpdateRootPageId(1);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    latch_.WUnlock();
+    return true;
+  }
+
+  Path path;
+  FindLeaf(key, &path);
+  auto *leaf = reinterpret_cast<LeafPage *>(path.pages.back()->GetData());
+  int index = leaf->LowerBound(key);
+  if (index < leaf->GetSize() && leaf->KeyAt(index) == key) {
+    UnpinPath(path, false);
+    latch_.WUnlock();
+    return false;
+  }
+  if (!leaf->Insert(index, key, value)) {
+    SplitLeaf(&path, index, key, value);
+  }
+  UnpinPath(path, true);
+  latch_.WUnlock();
+  return true;
+}
+
+/*
+ * Split the leaf at the end of path around the middle byte, with key & value
+ * added at index. The separator pushed up is the shortest prefix of the right
+ * half's first key that is still greater than the left half's last key; it
+ * becomes the high fence of the left half and the low fence of the right half.
+ */
+void VarlenBPlusTree::SplitLeaf(Path *path, int index, std::string_view key, const RID &value) {
+  auto *leaf = reinterpret_cast<LeafPage *>(path->pages.back()->GetData());
+  auto entries = leaf->GetEntries();
+  entries.emplace(entries.begin() + index, std::string(key), value);
+  size_t mid = SplitPoint(entries);
+  std::vector<std::pair<std::string, RID>> right_entries(entries.begin() + mid, entries.end());
+  entries.resize(mid);
+
+  const std::string &last = entries.back().first;
+  const std::string &first = right_entries.front().first;
+  size_t length = std::min(last.size(), first.size());
+  size_t common = std::mismatch(last.begin(), last.begin() + length, first.begin()).first - last.begin();
+  std::string separator = first.substr(0, common + 1);
+
+  std::string low(leaf->GetLowFence());
+  std::string high(leaf->GetHighFence());
+  const std::string *high_fence = leaf->HasHighFence() ? &high : nullptr;
+  page_id_t right_page_id;
+  auto *right = reinterpret_cast<LeafPage *>(NewPage(&right_page_id)->GetData());
+  right->Init(right_page_id, IndexPageType::LEAF_PAGE, separator, high_fence);
+  right->Reset(separator, high_fence, right_entries);
+  right->SetNextPageId(leaf->GetNextPageId());
+  leaf->Reset(low, &separator, entries);
+  leaf->SetNextPageId(right_page_id);
+
+  InsertIntoParent(path, path->pages.size() - 1, separator, right_page_id);
+  buffer_pool_manager_->UnpinPage(right_page_id, true);
+}
+
+/*
+ * Insert key & right_page_id after the page at level of path in its parent.
+ * A full parent is split around its middle byte and its middle key moves up
+ * as the separator; a split root gets a new root above it.
+ */
+void VarlenBPlusTree::InsertIntoParent(Path *path, size_t level, const std::string &key, page_id_t right_page_id) {
+  if (level == 0) {
+    page_id_t root_page_id;
+    auto *root = reinterpret_cast<InternalPage *>(NewPage(&root_page_id)->GetData());
+    root->Init(root_page_id, IndexPageType::INTERNAL_PAGE, "", nullptr);
+    root->Reset("", nullptr, {{"", root_page_id_}, {key, right_page_id}});
+    root_page_id_ = root_page_id;
+    UpdateRootPageId(0);
+    buffer_pool_manager_->UnpinPage(root_page_id, true);
+    return;
+  }
+
+  auto *parent = reinterpret_cast<InternalPage *>(path->pages[level - 1]->GetData());
+  int index = path->child_indexes[level - 1] + 1;
+  if (parent->Insert(index, key, right_page_id)) {
+    return;
+  }
+  auto entries = parent->GetEntries();
+  entries.emplace(entries.begin() + index, key, right_page_id);
+  size_t mid = SplitPoint(entries);
+  std::string separator = std::move(entries[mid].first);
+  std::vector<std::pair<std::string, page_id_t>> right_entries(entries.begin() + mid, entries.end());
+  right_entries.front().first.clear();
+  entries.resize(mid);
+
+  std::string low(parent->GetLowFence());
+  std::string high(parent->GetHighFence());
+  const std::string *high_fence = parent->HasHighFence() ? &high : nullptr;
+  page_id_t new_page_id;
+  auto *new_parent = reinterpret_cast<InternalPage *>(NewPage(&new_page_id)->GetData());
+  new_parent->Init(new_page_id, IndexPageType::INTERNAL_PAGE, separator, high_fence);
+  new_parent->Reset(separator, high_fence, right_entries);
+  parent->Reset(low, &separator, entries);
+
+  InsertIntoParent(path, level - 1, separator, new_page_id);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+}
+
+template <typename ValueType>
+size_t VarlenBPlusTree::SplitPoint(const std::vector<std::pair<std::string, ValueType>> &entries) {
+  size_t total = 0;
+  for (const auto &entry : entries) {
+    total += entry.first.size() + sizeof(ValueType);
+  }
+  size_t bytes = 0;
+  size_t mid = 0;
+  while (mid < entries.size() && 2 * bytes < total) {
+    bytes += entries[mid++].first.size() + sizeof(ValueType);
+  }
+  return std::clamp<size_t>(mid, 1, entries.size() - 1);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * Delete key & value pair associated with input key
+ * If current tree is empty, return immdiately.
+ * Otherwise remove the entry from its leaf and merge underfull pages upwards.
+ */
+void VarlenBPlusTree::Remove(std::string_view key, Transaction *transaction) {
+  latch_.WLock();
+  if (IsEmpty()) {
+    latch_.WUnlock();
+    return;
+  }
+  Path path;
+  FindLeaf(key, &path);
+  auto *leaf = reinterpret_cast<LeafPage *>(path.pages.back()->GetData());
+  int index = leaf->LowerBound(key);
+  if (index == leaf->GetSize() || leaf->KeyAt(index) != key) {
+    UnpinPath(path, false);
+    latch_.WUnlock();
+    return;
+  }
+  leaf->Remove(index);
+
+  std::vector<page_id_t> deleted_page_ids;
+  CoalesceUp(&path, path.pages.size() - 1, &deleted_page_ids);
+  UnpinPath(path, true);
+  for (page_id_t page_id : deleted_page_ids) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  latch_.WUnlock();
+}
+
+/*
+ * Walk up path from level while pages get merged. At the root, an empty leaf
+ * empties the tree and an internal page with a single child hands the root
+ * over to that child.
+ */
+void VarlenBPlusTree::CoalesceUp(Path *path, size_t level, std::vector<page_id_t> *deleted_page_ids) {
+  for (; level > 0; level--) {
+    bool is_leaf = reinterpret_cast<BPlusTreePage *>(path->pages[level]->GetData())->IsLeafPage();
+    if (!(is_leaf ? Coalesce<LeafPage>(path, level, deleted_page_ids)
+                  : Coalesce<InternalPage>(path, level, deleted_page_ids))) {
+      return;
+    }
+  }
+
+  auto *root = reinterpret_cast<BPlusTreePage *>(path->pages[0]->GetData());
+  if (root->IsLeafPage()) {
+    if (root->GetSize() == 0) {
+      deleted_page_ids->push_back(root_page_id_);
+      root_page_id_ = INVALID_PAGE_ID;
+      UpdateRootPageId(0);
+    }
+    return;
+  }
+  if (root->GetSize() == 1) {
+    deleted_page_ids->push_back(root_page_id_);
+    root_page_id_ = reinterpret_cast<InternalPage *>(root)->ValueAt(0);
+    // a leaf that could not be merged away may be left empty
+    Page *child_page = FetchPage(root_page_id_);
+    auto *child = reinterpret_cast<BPlusTreePage *>(child_page->GetData());
+    if (child->IsLeafPage() && child->GetSize() == 0) {
+      deleted_page_ids->push_back(root_page_id_);
+      root_page_id_ = INVALID_PAGE_ID;
+    }
+    buffer_pool_manager_->UnpinPage(child_page->GetPageId(), false);
+    UpdateRootPageId(0);
+  }
+}
+
+/*
+ * Merge the page at level of path with its right sibling, or with its left
+ * sibling if it is the last child, when it fell below a quarter full. The
+ * merged page spans both fence ranges; an internal page takes the parent's
+ * separator as the key of the right page's first child. Siblings that do not
+ * fit into one page are left as they are.
+ */
+template <typename N>
+bool VarlenBPlusTree::Coalesce(Path *path, size_t level, std::vector<page_id_t> *deleted_page_ids) {
+  auto *node = reinterpret_cast<N *>(path->pages[level]->GetData());
+  auto *parent = reinterpret_cast<InternalPage *>(path->pages[level - 1]->GetData());
+  if (node->GetUsedBytes() >= N::Capacity() / 4 || parent->GetSize() < 2) {
+    return false;
+  }
+  int index = path->child_indexes[level - 1];
+  int right_index = index + 1 < parent->GetSize() ? index + 1 : index;
+  page_id_t left_page_id = parent->ValueAt(right_index - 1);
+  page_id_t right_page_id = parent->ValueAt(right_index);
+  auto *left = reinterpret_cast<N *>(FetchPage(left_page_id)->GetData());
+  auto *right = reinterpret_cast<N *>(FetchPage(right_page_id)->GetData());
+
+  auto entries = left->GetEntries();
+  auto right_entries = right->GetEntries();
+  if (!right->IsLeafPage()) {
+    right_entries.front().first = parent->KeyAt(right_index);
+  }
+  entries.insert(entries.end(), right_entries.begin(), right_entries.end());
+  std::string low(left->GetLowFence());
+  std::string high(right->GetHighFence());
+  const std::string *high_fence = right->HasHighFence() ? &high : nullptr;
+  bool fits = N::Fits(low, high_fence, entries, left->IsLeafPage());
+  if (fits) {
+    left->Reset(low, high_fence, entries);
+    left->SetNextPageId(right->GetNextPageId());
+    parent->Remove(right_index);
+    deleted_page_ids->push_back(right_page_id);
+  }
+  buffer_pool_manager_->UnpinPage(left_page_id, fits);
+  buffer_pool_manager_->UnpinPage(right_page_id, false);
+  return fits;
+}
+
+/*****************************************************************************
+ * INDEX ITERATOR
+ *****************************************************************************/
+VarlenBPlusTreeIterator VarlenBPlusTree::Begin() { return VarlenBPlusTreeIterator(this, ""); }
+
+VarlenBPlusTreeIterator VarlenBPlusTree::Begin(std::string_view key) {
+  return VarlenBPlusTreeIterator(this, std::string(key));
+}
+
+void VarlenBPlusTree::LoadItems(std::string_view key, bool inclusive, std::vector<VarlenMappingType> *items) {
+  latch_.RLock();
+  if (IsEmpty()) {
+    latch_.RUnlock();
+    return;
+  }
+  Path path;
+  FindLeaf(key, &path);
+  auto *leaf = reinterpret_cast<LeafPage *>(path.pages.back()->GetData());
+  int index = leaf->LowerBound(key);
+  if (!inclusive && index < leaf->GetSize() && leaf->KeyAt(index) == key) {
+    index++;
+  }
+  for (; index < leaf->GetSize(); index++) {
+    items->emplace_back(leaf->KeyAt(index), leaf->ValueAt(index));
+  }
+  page_id_t next_page_id = leaf->GetNextPageId();
+  UnpinPath(path, false);
+
+  // every key of the following leaves is past key
+  while (items->empty() && next_page_id != INVALID_PAGE_ID) {
+    Page *page = FetchPage(next_page_id);
+    leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    for (index = 0; index < leaf->GetSize(); index++) {
+      items->emplace_back(leaf->KeyAt(index), leaf->ValueAt(index));
+    }
+    next_page_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  }
+  latch_.RUnlock();
+}
+
+/*****************************************************************************
+ * UTILITIES
+ *****************************************************************************/
+Page *VarlenBPlusTree::FetchPage(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch page");
+  }
+  return page;
+}
+
+Page *VarlenBPlusTree::NewPage(page_id_t *page_id) {
+  Page *page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new page");
+  }
+  return page;
+}
+
+/*
+ * Update/Insert root page id in header page(header_page_id_, page 0 unless the
+ * tree was given its own)
+ * @parameter: insert_record      defualt value is false. When set to true,
+ * insert a record <index_name, root_page_id> into header page instead of
+ * updating it.
+ */
+void VarlenBPlusTree::UpdateRootPageId(int insert_record) {
+  auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id_));
+  if (insert_record == 0 || !header_page->InsertRecord(index_name_, root_page_id_)) {
+    header_page->UpdateRecord(index_name_, root_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
+}
+
+}  // namespace bustub
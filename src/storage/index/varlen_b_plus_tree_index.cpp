@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree_index.cpp
+//
+// Identification: src/storage/index/varlen_b_plus_tree_index.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "storage/index/key_encoder.h"
+#include "storage/index/varlen_b_plus_tree_index.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+VarlenBPlusTreeIndex::VarlenBPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata,
+                                           BufferPoolManager *buffer_pool_manager, page_id_t header_page_id)
+    : Index(std::move(metadata)), container_(GetMetadata()->GetName(), buffer_pool_manager, header_page_id) {}
+
+std::string VarlenBPlusTreeIndex::EncodeKey(const Tuple &key) const {
+  char buffer[VARLEN_KEY_MAX_SIZE + 1];
+  KeyEncoder encoder(buffer, sizeof(buffer));
+  encoder.PutTuple(key, GetKeySchema());
+  return std::string(buffer, std::min(encoder.GetLength(), sizeof(buffer)));
+}
+
+void VarlenBPlusTreeIndex::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  container_.Insert(EncodeKey(key), rid, transaction);
+}
+
+void VarlenBPlusTreeIndex::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  container_.Remove(EncodeKey(key), transaction);
+}
+
+void VarlenBPlusTreeIndex::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  container_.GetValue(EncodeKey(key), result, transaction);
+}
+
+VarlenBPlusTreeIterator VarlenBPlusTreeIndex::GetBeginIterator() { return container_.Begin(); }
+
+VarlenBPlusTreeIterator VarlenBPlusTreeIndex::GetBeginIterator(const Tuple &key) {
+  return container_.Begin(EncodeKey(key));
+}
+
+}  // namespace bustub
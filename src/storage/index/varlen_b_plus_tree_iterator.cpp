@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// varlen_b_plus_tree_iterator.cpp
+//
+// Identification: src/storage/index/varlen_b_plus_tree_iterator.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+
+#include "storage/index/varlen_b_plus_tree.h"
+#include "storage/index/varlen_b_plus_tree_iterator.h"
+
+namespace bustub {
+
+VarlenBPlusTreeIterator::VarlenBPlusTreeIterator(VarlenBPlusTree *tree, const std::string &key) : tree_(tree) {
+  tree_->LoadItems(key, true, &items_);
+}
+
+bool VarlenBPlusTreeIterator::IsEnd() { return item_index_ == items_.size(); }
+
+const VarlenMappingType &VarlenBPlusTreeIterator::operator*() { return items_[item_index_]; }
+
+VarlenBPlusTreeIterator &VarlenBPlusTreeIterator::operator++() {
+  if (++item_index_ == items_.size()) {
+    std::string last_key = std::move(items_.back().first);
+    items_.clear();
+    item_index_ = 0;
+    tree_->LoadItems(last_key, false, &items_);
+  }
+  return *this;
+}
+
+}  // namespace bustub
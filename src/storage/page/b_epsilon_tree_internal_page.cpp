@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree_internal_page.cpp
+//
+// Identification: src/storage/page/b_epsilon_tree_internal_page.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "storage/page/b_epsilon_tree_internal_page.h"
+#include "storage/page/b_plus_tree_search.h"
+
+namespace bustub {
+
+/*****************************************************************************
+ * HELPER METHODS AND UTILITIES
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INTERNAL_PAGE_TYPE::Init(page_id_t page_id, int max_size, int buffer_max_size) {
+  SetPageType(IndexPageType::INTERNAL_PAGE);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(INVALID_PAGE_ID);
+  SetMaxSize(max_size);
+  int capacity =
+      static_cast<int>((PAGE_SIZE - B_EPSILON_PAGE_HEADER_SIZE - max_size * sizeof(Pivot)) / sizeof(Message));
+  buffer_size_ = 0;
+  buffer_max_size_ = std::min(buffer_max_size, capacity);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+KeyType B_EPSILON_TREE_INTERNAL_PAGE_TYPE::KeyAt(int index) const { return array_[index].first; }
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t B_EPSILON_TREE_INTERNAL_PAGE_TYPE::ValueAt(int index) const { return array_[index].second; }
+
+/*
+ * The last child whose pivot is not greater than key; the first pivot is
+ * unused, so everything below the second one goes to the first child.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int B_EPSILON_TREE_INTERNAL_PAGE_TYPE::ChildIndex(const KeyType &key, const KeyComparator &comparator) const {
+  return BPlusTreeSearch<KeyType, page_id_t, KeyComparator>::UpperBound(array_, 1, GetSize(), key, comparator) - 1;
+}
+
+/*****************************************************************************
+ * BUFFER
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+int B_EPSILON_TREE_INTERNAL_PAGE_TYPE::GetBufferSize() const { return buffer_size_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+int B_EPSILON_TREE_INTERNAL_PAGE_TYPE::GetBufferMaxSize() const { return buffer_max_size_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+bool B_EPSILON_TREE_INTERNAL_PAGE_TYPE::IsBufferFull() const { return buffer_size_ >= buffer_max_size_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_INTERNAL_PAGE_TYPE::MessageAt(int index) const -> const Message & { return Messages()[index]; }
+
+INDEX_TEMPLATE_ARGUMENTS
+int B_EPSILON_TREE_INTERNAL_PAGE_TYPE::MessageIndex(const KeyType &key, const KeyComparator &comparator,
+                                                     bool upper) const {
+  const Message *messages = Messages();
+  if (upper) {
+    return std::upper_bound(messages, messages + buffer_size_, key,
+                            [&](const KeyType &k, const Message &m) { return comparator(k, m.key_) < 0; }) -
+           messages;
+  }
+  return std::lower_bound(messages, messages + buffer_size_, key,
+                          [&](const Message &m, const KeyType &k) { return comparator(m.key_, k) < 0; }) -
+         messages;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_INTERNAL_PAGE_TYPE::FindMessage(const KeyType &key, const KeyComparator &comparator) const
+    -> const Message * {
+  int index = MessageIndex(key, comparator);
+  if (index < buffer_size_ && comparator(Messages()[index].key_, key) == 0) {
+    return &Messages()[index];
+  }
+  return nullptr;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INTERNAL_PAGE_TYPE::AddMessage(const Message &message, const KeyComparator &comparator) {
+  Message *messages = Messages();
+  int index = MessageIndex(message.key_, comparator);
+  if (index < buffer_size_ && comparator(messages[index].key_, message.key_) == 0) {
+    messages[index] = message;
+    return;
+  }
+  std::copy_backward(messages + index, messages + buffer_size_, messages + buffer_size_ + 1);
+  messages[index] = message;
+  buffer_size_++;
+}
+
+/*****************************************************************************
+ * REBUILD
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_INTERNAL_PAGE_TYPE::GetPivots() const -> std::vector<Pivot> {
+  return std::vector<Pivot>(array_, array_ + GetSize());
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto B_EPSILON_TREE_INTERNAL_PAGE_TYPE::GetMessages() const -> std::vector<Message> {
+  return std::vector<Message>(Messages(), Messages() + buffer_size_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_EPSILON_TREE_INTERNAL_PAGE_TYPE::Reset(const Pivot *pivots, int num_pivots, const Message *messages,
+                                               int num_messages) {
+  std::copy(pivots, pivots + num_pivots, array_);
+  SetSize(num_pivots);
+  std::copy(messages, messages + num_messages, Messages());
+  buffer_size_ = num_messages;
+}
+
+template class BEpsilonTreeInternalPage<GenericKey<4>, RID, GenericComparator<4>>;
+template class BEpsilonTreeInternalPage<GenericKey<8>, RID, GenericComparator<8>>;
+template class BEpsilonTreeInternalPage<GenericKey<16>, RID, GenericComparator<16>>;
+template class BEpsilonTreeInternalPage<GenericKey<32>, RID, GenericComparator<32>>;
+template class BEpsilonTreeInternalPage<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
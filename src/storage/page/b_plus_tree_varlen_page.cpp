@@ -0,0 +1,268 @@
+//===----------------------------------------------------------------------===//
+//
+//                         CMU-DB Project (15-445/645)
+//                         ***DO NO SHARE PUBLICLY***
+//
+// Identification: src/page/b_plus_tree_varlen_page.cpp
+//
+// Copyright (c) 2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/rid.h"
+#include "storage/page/b_plus_tree_varlen_page.h"
+
+namespace bustub {
+
+namespace {
+// length of the common prefix of the fences; the rightmost page has no upper bound, hence no prefix
+size_t FencePrefixLength(std::string_view low_fence, const std::string *high_fence) {
+  if (high_fence == nullptr) {
+    return 0;
+  }
+  size_t length = std::min(low_fence.size(), high_fence->size());
+  return std::mismatch(low_fence.begin(), low_fence.begin() + length, high_fence->begin()).first - low_fence.begin();
+}
+}  // namespace
+
+/*****************************************************************************
+ * HELPER METHODS AND UTILITIES
+ *****************************************************************************/
+/*
+ * Init method after creating a new page: set page type, page id, fences and
+ * next page id, and make the page empty. Varlen pages split by bytes, so max
+ * size is unused.
+ */
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::Init(page_id_t page_id, IndexPageType page_type, std::string_view low_fence,
+                                        const std::string *high_fence) {
+  SetPageType(page_type);
+  SetPageId(page_id);
+  SetParentPageId(INVALID_PAGE_ID);
+  SetMaxSize(0);
+  SetLSN();
+  next_page_id_ = INVALID_PAGE_ID;
+  reserved_ = 0;
+  Reset(low_fence, high_fence, {});
+}
+
+template <typename ValueType>
+page_id_t B_PLUS_TREE_VARLEN_PAGE_TYPE::GetNextPageId() const {
+  return next_page_id_;
+}
+
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) {
+  next_page_id_ = next_page_id;
+}
+
+template <typename ValueType>
+std::string_view B_PLUS_TREE_VARLEN_PAGE_TYPE::GetLowFence() const {
+  return {Data() + PAGE_SIZE - low_fence_length_, low_fence_length_};
+}
+
+template <typename ValueType>
+bool B_PLUS_TREE_VARLEN_PAGE_TYPE::HasHighFence() const {
+  return high_fence_length_ != NO_HIGH_FENCE;
+}
+
+template <typename ValueType>
+std::string_view B_PLUS_TREE_VARLEN_PAGE_TYPE::GetHighFence() const {
+  return HasHighFence() ? std::string_view{Data() + FenceBegin(), high_fence_length_} : std::string_view{};
+}
+
+template <typename ValueType>
+std::string_view B_PLUS_TREE_VARLEN_PAGE_TYPE::GetPrefix() const {
+  return GetLowFence().substr(0, prefix_length_);
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::FenceBegin() const {
+  return PAGE_SIZE - low_fence_length_ - (HasHighFence() ? high_fence_length_ : 0);
+}
+
+template <typename ValueType>
+std::string_view B_PLUS_TREE_VARLEN_PAGE_TYPE::SuffixAt(int index) const {
+  return {Data() + slots_[index].key_offset_, slots_[index].key_length_};
+}
+
+/*
+ * The full key at index: the page prefix followed by the stored suffix. The
+ * first key of an internal page is unused and comes back as the prefix.
+ */
+template <typename ValueType>
+std::string B_PLUS_TREE_VARLEN_PAGE_TYPE::KeyAt(int index) const {
+  std::string key(GetPrefix());
+  key.append(SuffixAt(index));
+  return key;
+}
+
+template <typename ValueType>
+ValueType B_PLUS_TREE_VARLEN_PAGE_TYPE::ValueAt(int index) const {
+  return slots_[index].value_;
+}
+
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::SetValueAt(int index, const ValueType &value) {
+  slots_[index].value_ = value;
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::GetUsedBytes() const {
+  return GetSize() * sizeof(Slot) + key_bytes_;
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::Capacity() {
+  return PAGE_SIZE - VARLEN_PAGE_HEADER_SIZE;
+}
+
+/*****************************************************************************
+ * LOOKUP
+ *****************************************************************************/
+/*
+ * Binary search over the suffixes. Only the part of key past the page prefix
+ * is compared, unless key does not start with the prefix at all, in which
+ * case it sorts before or after every key of the page.
+ */
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::Search(std::string_view key, bool upper) const {
+  int first = IsLeafPage() ? 0 : 1;
+  int cmp = key.substr(0, prefix_length_).compare(GetPrefix());
+  if (cmp != 0) {
+    return cmp < 0 ? first : GetSize();
+  }
+  std::string_view suffix = key.substr(prefix_length_);
+  int left = first;
+  int right = GetSize();
+  while (left < right) {
+    int mid = left + (right - left) / 2;
+    int c = SuffixAt(mid).compare(suffix);
+    if (c < 0 || (upper && c == 0)) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  return left;
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::LowerBound(std::string_view key) const {
+  return Search(key, false);
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_VARLEN_PAGE_TYPE::ChildIndex(std::string_view key) const {
+  return Search(key, true) - 1;
+}
+
+/*****************************************************************************
+ * INSERTION AND REMOVAL
+ *****************************************************************************/
+/*
+ * Insert key & value at index. key must lie within the fences; the first key
+ * of an internal page is not stored. Returns false, leaving the page
+ * unchanged, if even a compacted page has no room for the entry.
+ */
+template <typename ValueType>
+bool B_PLUS_TREE_VARLEN_PAGE_TYPE::Insert(int index, std::string_view key, const ValueType &value) {
+  std::string_view suffix = (!IsLeafPage() && index == 0) ? std::string_view{} : key.substr(prefix_length_);
+  int needed = sizeof(Slot) + suffix.size();
+  if (GetUsedBytes() + needed > FenceBegin() - VARLEN_PAGE_HEADER_SIZE) {
+    return false;
+  }
+  int slots_end = VARLEN_PAGE_HEADER_SIZE + (GetSize() + 1) * sizeof(Slot);
+  if (key_begin_ - static_cast<int>(suffix.size()) < slots_end) {
+    Compact();
+  }
+
+  key_begin_ -= suffix.size();
+  memcpy(Data() + key_begin_, suffix.data(), suffix.size());
+  key_bytes_ += suffix.size();
+  std::move_backward(slots_ + index, slots_ + GetSize(), slots_ + GetSize() + 1);
+  slots_[index] = {key_begin_, static_cast<uint16_t>(suffix.size()), value};
+  IncreaseSize(1);
+  return true;
+}
+
+/*
+ * Remove the entry at index. Its key bytes stay behind as a hole until the
+ * next compaction.
+ */
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::Remove(int index) {
+  key_bytes_ -= slots_[index].key_length_;
+  std::move(slots_ + index + 1, slots_ + GetSize(), slots_ + index);
+  IncreaseSize(-1);
+}
+
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::Compact() {
+  char buffer[PAGE_SIZE];
+  int end = FenceBegin();
+  int offset = end;
+  for (int i = 0; i < GetSize(); i++) {
+    offset -= slots_[i].key_length_;
+    memcpy(buffer + offset, Data() + slots_[i].key_offset_, slots_[i].key_length_);
+    slots_[i].key_offset_ = offset;
+  }
+  memcpy(Data() + offset, buffer + offset, end - offset);
+  key_begin_ = offset;
+}
+
+/*****************************************************************************
+ * REBUILDING
+ *****************************************************************************/
+template <typename ValueType>
+std::vector<std::pair<std::string, ValueType>> B_PLUS_TREE_VARLEN_PAGE_TYPE::GetEntries() const {
+  std::vector<std::pair<std::string, ValueType>> entries;
+  entries.reserve(GetSize());
+  for (int i = 0; i < GetSize(); i++) {
+    entries.emplace_back((!IsLeafPage() && i == 0) ? std::string{} : KeyAt(i), ValueAt(i));
+  }
+  return entries;
+}
+
+template <typename ValueType>
+bool B_PLUS_TREE_VARLEN_PAGE_TYPE::Fits(std::string_view low_fence, const std::string *high_fence,
+                                        const std::vector<std::pair<std::string, ValueType>> &entries, bool is_leaf) {
+  size_t prefix_length = FencePrefixLength(low_fence, high_fence);
+  size_t bytes = VARLEN_PAGE_HEADER_SIZE + low_fence.size() + (high_fence == nullptr ? 0 : high_fence->size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    bytes += sizeof(Slot) + ((!is_leaf && i == 0) ? 0 : entries[i].first.size() - prefix_length);
+  }
+  return bytes <= PAGE_SIZE;
+}
+
+/*
+ * Rebuild the page from scratch, e.g. after a split or merge changed its
+ * range: store the new fences, derive the prefix from them and store every
+ * key without it. The fences may point into this page.
+ */
+template <typename ValueType>
+void B_PLUS_TREE_VARLEN_PAGE_TYPE::Reset(std::string_view low_fence, const std::string *high_fence,
+                                         const std::vector<std::pair<std::string, ValueType>> &entries) {
+  BUSTUB_ASSERT(Fits(low_fence, high_fence, entries, IsLeafPage()), "entries do not fit into the page");
+  std::string low(low_fence);
+  std::string high(high_fence == nullptr ? "" : *high_fence);
+
+  low_fence_length_ = low.size();
+  memcpy(Data() + PAGE_SIZE - low.size(), low.data(), low.size());
+  high_fence_length_ = high_fence == nullptr ? NO_HIGH_FENCE : high.size();
+  memcpy(Data() + PAGE_SIZE - low.size() - high.size(), high.data(), high.size());
+  prefix_length_ = FencePrefixLength(low, high_fence == nullptr ? nullptr : &high);
+  key_begin_ = FenceBegin();
+  key_bytes_ = 0;
+  SetSize(0);
+  for (size_t i = 0; i < entries.size(); i++) {
+    Insert(i, entries[i].first, entries[i].second);
+  }
+}
+
+template class BPlusTreeVarlenPage<RID>;
+template class BPlusTreeVarlenPage<page_id_t>;
+}  // namespace bustub
@@ -11,39 +11,132 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/page/hash_table_block_page.h"
+#include "common/logger.h"
 #include "storage/index/generic_key.h"
 
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 KeyType HASH_TABLE_BLOCK_TYPE::KeyAt(slot_offset_t bucket_ind) const {
-  return {};
+  return array_[bucket_ind].first;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 ValueType HASH_TABLE_BLOCK_TYPE::ValueAt(slot_offset_t bucket_ind) const {
-  return {};
+  return array_[bucket_ind].second;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BLOCK_TYPE::Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) {
-  return false;
+  char mask = static_cast<char>(1 << bucket_ind % 8);
+  // 用fetch_or抢占slot，已被占用则失败
+  if ((occupied_[bucket_ind / 8].fetch_or(mask) & mask) != 0) {
+    return false;
+  }
+  array_[bucket_ind] = std::make_pair(key, value);
+  readable_[bucket_ind / 8].fetch_or(mask);
+  return true;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind) {}
+void HASH_TABLE_BLOCK_TYPE::Remove(slot_offset_t bucket_ind) {
+  readable_[bucket_ind / 8].fetch_and(static_cast<char>(~(1 << bucket_ind % 8)));
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BLOCK_TYPE::IsOccupied(slot_offset_t bucket_ind) const {
-  return false;
+  return (occupied_[bucket_ind / 8] & (1 << bucket_ind % 8)) != 0;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BLOCK_TYPE::IsReadable(slot_offset_t bucket_ind) const {
+  return (readable_[bucket_ind / 8] & (1 << bucket_ind % 8)) != 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_BLOCK_TYPE::GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) {
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (IsReadable(i) && cmp(key, KeyAt(i)) == 0) {
+      result->push_back(ValueAt(i));
+    }
+  }
+  return !static_cast<bool>(result->empty());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_BLOCK_TYPE::Insert(KeyType key, ValueType value, KeyComparator cmp) {
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (IsReadable(i) && cmp(key, KeyAt(i)) == 0 && value == ValueAt(i)) {
+      return false;
+    }
+  }
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (!IsOccupied(i) && Insert(i, key, value)) {
+      return true;
+    }
+  }
   return false;
 }
 
-// DO NOT REMOVE ANYTHING BELOW THIS LINE
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_BLOCK_TYPE::Remove(KeyType key, ValueType value, KeyComparator cmp) {
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (IsReadable(i) && cmp(key, KeyAt(i)) == 0 && value == ValueAt(i)) {
+      Remove(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BLOCK_TYPE::NumReadable() {
+  uint32_t res = 0;
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (IsReadable(i)) {
+      res++;
+    }
+  }
+  return res;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_BLOCK_TYPE::IsFull() {
+  for (slot_offset_t i = 0; i < BLOCK_ARRAY_SIZE; i++) {
+    if (!IsOccupied(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_BLOCK_TYPE::IsEmpty() {
+  return NumReadable() == 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BLOCK_TYPE::PrintBucket() {
+  uint32_t size = 0;
+  uint32_t taken = 0;
+  uint32_t free = 0;
+  for (slot_offset_t bucket_ind = 0; bucket_ind < BLOCK_ARRAY_SIZE; bucket_ind++) {
+    if (!IsOccupied(bucket_ind)) {
+      continue;
+    }
+
+    size++;
+
+    if (IsReadable(bucket_ind)) {
+      taken++;
+    } else {
+      free++;
+    }
+  }
+
+  LOG_INFO("Block Capacity: %lu, Size: %u, Taken: %u, Tombstones: %u", BLOCK_ARRAY_SIZE, size, taken, free);
+}
+
 template class HashTableBlockPage<int, int, IntComparator>;
 template class HashTableBlockPage<GenericKey<4>, RID, GenericComparator<4>>;
 template class HashTableBlockPage<GenericKey<8>, RID, GenericComparator<8>>;
@@ -78,6 +78,13 @@ void HASH_TABLE_BUCKET_TYPE::RemoveAt(uint32_t bucket_idx) {
   array_[bucket_idx] = std::pair<KeyType, ValueType>();
 }
 
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BUCKET_TYPE::InsertAt(uint32_t bucket_idx, const KeyType &key, const ValueType &value) {
+  SetOccupied(bucket_idx);
+  SetReadable(bucket_idx);
+  array_[bucket_idx] = std::make_pair(key, value);
+}
+
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BUCKET_TYPE::IsOccupied(uint32_t bucket_idx) const {
   return occupied_[bucket_idx / 8] & (1 << bucket_idx % 8);
@@ -28,6 +28,8 @@ uint32_t HashTableDirectoryPage::GetGlobalDepth() { return global_depth_; }
 
 uint32_t HashTableDirectoryPage::GetGlobalDepthMask() { return (1 << global_depth_) - 1; }
 
+uint32_t HashTableDirectoryPage::GetLocalDepthMask(uint32_t bucket_idx) { return (1 << GetLocalDepth(bucket_idx)) - 1; }
+
 void HashTableDirectoryPage::IncrGlobalDepth() {
   if (1 << GetGlobalDepth() == DIRECTORY_ARRAY_SIZE) {
     throw Exception(ExceptionType::OUT_OF_RANGE, "global depth out of upperbound");
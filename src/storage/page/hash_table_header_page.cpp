@@ -12,23 +12,35 @@
 
 #include "storage/page/hash_table_header_page.h"
 
+#include "common/exception.h"
+
 namespace bustub {
-page_id_t HashTableHeaderPage::GetBlockPageId(size_t index) { return 0; }
+page_id_t HashTableHeaderPage::GetBlockPageId(size_t index) {
+  assert(index < next_ind_);
+  return block_page_ids_[index];
+}
+
+page_id_t HashTableHeaderPage::GetPageId() const { return page_id_; }
 
-page_id_t HashTableHeaderPage::GetPageId() const { return 0; }
+void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) { page_id_ = page_id; }
 
-void HashTableHeaderPage::SetPageId(bustub::page_id_t page_id) {}
+lsn_t HashTableHeaderPage::GetLSN() const { return lsn_; }
 
-lsn_t HashTableHeaderPage::GetLSN() const { return 0; }
+void HashTableHeaderPage::SetLSN(lsn_t lsn) { lsn_ = lsn; }
 
-void HashTableHeaderPage::SetLSN(lsn_t lsn) {}
+void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {
+  if (next_ind_ == MaxNumBlocks()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "header page is full of block page ids");
+  }
+  block_page_ids_[next_ind_++] = page_id;
+}
 
-void HashTableHeaderPage::AddBlockPageId(page_id_t page_id) {}
+size_t HashTableHeaderPage::NumBlocks() { return next_ind_; }
 
-size_t HashTableHeaderPage::NumBlocks() { return 0; }
+size_t HashTableHeaderPage::MaxNumBlocks() { return (PAGE_SIZE - sizeof(HashTableHeaderPage)) / sizeof(page_id_t); }
 
-void HashTableHeaderPage::SetSize(size_t size) {}
+void HashTableHeaderPage::SetSize(size_t size) { size_ = size; }
 
-size_t HashTableHeaderPage::GetSize() const { return 0; }
+size_t HashTableHeaderPage::GetSize() const { return size_; }
 
 }  // namespace bustub
@@ -305,10 +305,16 @@ bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
   return true;
 }
 
-bool TablePage::GetFirstTupleRid(RID *first_rid) {
+bool TablePage::TupleMatches(const RID &rid, const TupleFilter &filter) {
+  uint32_t slot_num = rid.GetSlotNum();
+  return slot_num < GetTupleCount() && !IsDeleted(GetTupleSize(slot_num)) &&
+         filter.Matches(GetData() + GetTupleOffsetAtSlot(slot_num));
+}
+
+bool TablePage::GetFirstTupleRid(RID *first_rid, const TupleFilter *filter) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    if (!IsDeleted(GetTupleSize(i)) && (filter == nullptr || filter->Matches(GetData() + GetTupleOffsetAtSlot(i)))) {
       first_rid->Set(GetTablePageId(), i);
       return true;
     }
@@ -317,11 +323,11 @@ bool TablePage::GetFirstTupleRid(RID *first_rid) {
   return false;
 }
 
-bool TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) {
+bool TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid, const TupleFilter *filter) {
   BUSTUB_ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
   // Find and return the first valid tuple after our current slot number.
   for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); ++i) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    if (!IsDeleted(GetTupleSize(i)) && (filter == nullptr || filter->Matches(GetData() + GetTupleOffsetAtSlot(i)))) {
       next_rid->Set(GetTablePageId(), i);
       return true;
     }
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <vector>
+
+#include "common/exception.h"
+#include "storage/table/tmp_tuple_file.h"
+
+namespace bustub {
+
+TmpTupleFile::TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) { tail_.Init(INVALID_PAGE_ID, PAGE_SIZE); }
+
+TmpTupleFile::~TmpTupleFile() {
+  for (page_id_t page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple) {
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  if (tail_.Insert(tuple, &tmp_tuple)) {
+    return;
+  }
+  FlushTail();
+  if (!tail_.Insert(tuple, &tmp_tuple)) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "tuple does not fit in a temporary page");
+  }
+}
+
+void TmpTupleFile::ReadPage(std::size_t index, std::vector<Tuple> *tuples) {
+  tuples->clear();
+  TmpTuplePage *page = &tail_;
+  if (index < page_ids_.size()) {
+    Page *raw_page = bpm_->FetchPage(page_ids_[index]);
+    if (raw_page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "no buffer pool frame to read a temporary page into");
+    }
+    page = reinterpret_cast<TmpTuplePage *>(raw_page);
+  }
+
+  for (uint32_t offset = page->GetFreeSpacePointer(); offset < PAGE_SIZE; offset = page->GetNextTupleOffset(offset)) {
+    tuples->emplace_back();
+    page->Get(TmpTuple(page->GetTablePageId(), offset), &tuples->back());
+  }
+
+  if (page != &tail_) {
+    bpm_->UnpinPage(page_ids_[index], false);
+  }
+}
+
+void TmpTupleFile::FlushTail() {
+  page_id_t page_id;
+  Page *page = bpm_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no buffer pool frame to spill a temporary page into");
+  }
+  memcpy(page->GetData(), tail_.GetData(), PAGE_SIZE);
+  reinterpret_cast<TmpTuplePage *>(page)->SetTablePageId(page_id);
+  bpm_->UnpinPage(page_id, true);
+  page_ids_.push_back(page_id);
+  tail_.Init(INVALID_PAGE_ID, PAGE_SIZE);
+}
+
+}  // namespace bustub
@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <chrono>  // NOLINT
+#include <iostream>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_set>
 #include <vector>
 
@@ -688,4 +691,459 @@ TEST(CatalogTest, DISABLED_IndexInteraction3) {
   remove("catalog_test.log");
 }
 
+// A B+ tree index over an existing table should be bulk loaded without disturbing the table's pages
+TEST(CatalogTest, BPlusTreeIndexBulkLoad) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(32, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  const std::string index_name{"index1"};
+
+  std::vector<Column> columns{{"A", TypeId::BIGINT}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  EXPECT_NE(Catalog::NULL_TABLE_INFO, table_info);
+
+  // Fill the table before the index exists, with keys out of order
+  const int32_t num_tuples = 1000;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(i * 7 % num_tuples), ValueFactory::GetIntegerValue(i)},
+                &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  auto *index_info = catalog->CreateIndex<BigintKeyType, BigintValueType, BigintComparatorType>(
+      txn.get(), index_name, table_name, table_schema, key_schema, key_attrs, BIGINT_SIZE, BigintHashFunctionType{},
+      IndexType::BPlusTree);
+  EXPECT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  auto *index = index_info->index_.get();
+
+  // Every tuple is still intact and can be found through the index
+  int32_t count = 0;
+  std::vector<RID> results{};
+  for (auto tuple = table_info->table_->Begin(txn.get()); tuple != table_info->table_->End(); ++tuple) {
+    EXPECT_EQ(tuple->GetValue(&table_schema, 0).GetAs<int64_t>(),
+              tuple->GetValue(&table_schema, 1).GetAs<int32_t>() * 7 % num_tuples);
+    results.clear();
+    index->ScanKey(tuple->KeyFromTuple(table_schema, key_schema, key_attrs), &results, txn.get());
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(tuple->GetRid(), results[0]);
+    count++;
+  }
+  EXPECT_EQ(num_tuples, count);
+
+  // The index keeps working as a regular B+ tree afterwards
+  Tuple key{std::vector<Value>{ValueFactory::GetBigIntValue(num_tuples)}, &key_schema};
+  index->InsertEntry(key, RID{}, txn.get());
+  results.clear();
+  index->ScanKey(key, &results, txn.get());
+  ASSERT_EQ(1, results.size());
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// A non-unique B+ tree index keeps every RID of a duplicated key and finds them all with one scan
+TEST(CatalogTest, NonUniqueBPlusTreeIndex) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(32, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::INTEGER}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  EXPECT_NE(Catalog::NULL_TABLE_INFO, table_info);
+
+  // A low-cardinality column, enough of each value to span several leaves
+  const int32_t num_tuples = 2000;
+  const int32_t num_values = 5;
+  std::vector<std::vector<RID>> expected(num_values + 1);
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetIntegerValue(i % num_values), ValueFactory::GetIntegerValue(i)},
+                &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+    expected[i % num_values].push_back(rid);
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::INTEGER}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+
+  // Too short a key leaves no room for the RID
+  EXPECT_THROW((catalog->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+                   txn.get(), "index0", table_name, table_schema, key_schema, key_attrs, 8,
+                   HashFunction<GenericKey<8>>{}, IndexType::NonUniqueBPlusTree)),
+               Exception);
+
+  auto *index_info = catalog->CreateIndex<GenericKey<16>, RID, GenericComparator<16>>(
+      txn.get(), "index1", table_name, table_schema, key_schema, key_attrs, 16, HashFunction<GenericKey<16>>{},
+      IndexType::NonUniqueBPlusTree);
+  EXPECT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  auto *index = index_info->index_.get();
+  auto key_of = [&](int32_t value) {
+    return Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(value)}, &key_schema};
+  };
+  auto check = [&]() {
+    for (int32_t value = 0; value <= num_values; value++) {
+      std::vector<RID> results{};
+      index->ScanKey(key_of(value), &results, txn.get());
+      ASSERT_EQ(expected[value], results) << value;
+    }
+  };
+  check();
+
+  // Inserting and deleting single entries touches just that RID of the key
+  index->InsertEntry(key_of(num_values), RID{1, 0}, txn.get());
+  index->InsertEntry(key_of(num_values), RID{0, 7}, txn.get());
+  expected[num_values] = {RID{0, 7}, RID{1, 0}};
+  for (int32_t value = 0; value < num_values; value++) {
+    auto &rids = expected[value];
+    for (size_t i = 0; i < rids.size(); i += 3) {
+      index->DeleteEntry(key_of(value), rids[i], txn.get());
+    }
+    std::vector<RID> left{};
+    for (size_t i = 0; i < rids.size(); i++) {
+      if (i % 3 != 0) {
+        left.push_back(rids[i]);
+      }
+    }
+    rids = left;
+  }
+  check();
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// A B-link tree index is bulk loaded like a B+ tree index and finds keys inserted by concurrent writers
+TEST(CatalogTest, BLinkBPlusTreeIndex) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::BIGINT}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  EXPECT_NE(Catalog::NULL_TABLE_INFO, table_info);
+
+  const int32_t num_tuples = 1000;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(i * 7 % num_tuples), ValueFactory::GetIntegerValue(i)},
+                &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  auto *index_info = catalog->CreateIndex<BigintKeyType, BigintValueType, BigintComparatorType>(
+      txn.get(), "index1", table_name, table_schema, key_schema, key_attrs, BIGINT_SIZE, BigintHashFunctionType{},
+      IndexType::BLinkBPlusTree);
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  auto *index = index_info->index_.get();
+
+  std::vector<RID> results{};
+  for (auto tuple = table_info->table_->Begin(txn.get()); tuple != table_info->table_->End(); ++tuple) {
+    results.clear();
+    index->ScanKey(tuple->KeyFromTuple(table_schema, key_schema, key_attrs), &results, txn.get());
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(tuple->GetRid(), results[0]);
+  }
+
+  // Writers split the bulk loaded pages under each other and under the readers
+  const int32_t num_threads = 4;
+  const int32_t keys_per_thread = 1000;
+  auto key_of = [&](int64_t value) {
+    return Tuple{std::vector<Value>{ValueFactory::GetBigIntValue(value)}, &key_schema};
+  };
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      Transaction thread_txn(t + 1);
+      std::vector<RID> found{};
+      for (int32_t i = 0; i < keys_per_thread; i++) {
+        int64_t value = num_tuples + i * num_threads + t;
+        index->InsertEntry(key_of(value), RID(t, i), &thread_txn);
+        found.clear();
+        index->ScanKey(key_of(value % num_tuples), &found, &thread_txn);
+        EXPECT_EQ(1, found.size());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int32_t t = 0; t < num_threads; t++) {
+    for (int32_t i = 0; i < keys_per_thread; i++) {
+      results.clear();
+      index->ScanKey(key_of(num_tuples + i * num_threads + t), &results, txn.get());
+      ASSERT_EQ(1, results.size());
+      EXPECT_EQ(RID(t, i), results[0]);
+    }
+  }
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// A B-epsilon tree index answers point and range scans through its pending messages
+TEST(CatalogTest, BEpsilonTreeIndex) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(32, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::INTEGER}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  EXPECT_NE(Catalog::NULL_TABLE_INFO, table_info);
+
+  std::vector<Column> key_columns{{"A", TypeId::INTEGER}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  auto *index_info = catalog->CreateIndex<GenericKey<16>, RID, GenericComparator<16>>(
+      txn.get(), "index1", table_name, table_schema, key_schema, key_attrs, 16, HashFunction<GenericKey<16>>{},
+      IndexType::BEpsilonTree);
+  EXPECT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  auto *index = dynamic_cast<BEpsilonTreeIndex<GenericKey<16>, RID, GenericComparator<16>> *>(index_info->index_.get());
+  ASSERT_NE(nullptr, index);
+  auto key_of = [&](int32_t value) {
+    return Tuple{std::vector<Value>{ValueFactory::GetIntegerValue(value)}, &key_schema};
+  };
+
+  // Enough entries to flush buffers down to the leaves, ten for each of 500 values
+  const int32_t num_values = 500;
+  for (int32_t i = 0; i < num_values * 10; i++) {
+    index->InsertEntry(key_of(i % num_values), RID{i / num_values, static_cast<uint32_t>(i)}, txn.get());
+  }
+  // Delete the first RID of every even value
+  for (int32_t value = 0; value < num_values; value += 2) {
+    index->DeleteEntry(key_of(value), RID{0, static_cast<uint32_t>(value)}, txn.get());
+  }
+
+  for (int32_t value = 0; value < num_values; value++) {
+    std::vector<RID> results{};
+    index->ScanKey(key_of(value), &results, txn.get());
+    ASSERT_EQ(value % 2 == 0 ? 9 : 10, results.size()) << value;
+    EXPECT_EQ(RID(9, static_cast<uint32_t>(9 * num_values + value)), results.back());
+  }
+  std::vector<RID> results{};
+  index->ScanRange(key_of(100), key_of(199), &results, txn.get());
+  EXPECT_EQ(50 * 9 + 50 * 10, results.size());
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// Indexes built by several threads find every tuple of a table spanning many pages
+TEST(CatalogTest, ParallelIndexBuild) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::BIGINT}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  const int32_t num_tuples = 5000;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(i * 7 % num_tuples), ValueFactory::GetIntegerValue(i)},
+                &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  for (auto index_type : {IndexType::ExtendibleHashTable, IndexType::LinearProbeHashTable, IndexType::BPlusTree}) {
+    auto *index_info = catalog->CreateIndex<BigintKeyType, BigintValueType, BigintComparatorType>(
+        txn.get(), "index" + std::to_string(static_cast<int>(index_type)), table_name, table_schema, key_schema,
+        key_attrs, BIGINT_SIZE, BigintHashFunctionType{}, index_type, 4);
+    ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+    int32_t count = 0;
+    std::vector<RID> results{};
+    for (auto tuple = table_info->table_->Begin(txn.get()); tuple != table_info->table_->End(); ++tuple) {
+      results.clear();
+      index_info->index_->ScanKey(tuple->KeyFromTuple(table_schema, key_schema, key_attrs), &results, txn.get());
+      ASSERT_EQ(1, results.size());
+      EXPECT_EQ(tuple->GetRid(), results[0]);
+      count++;
+    }
+    EXPECT_EQ(num_tuples, count);
+
+    // a batched lookup replaces the results of the one before
+    std::vector<Tuple> keys;
+    for (int64_t key = 0; key < 10; key++) {
+      keys.emplace_back(std::vector<Value>{ValueFactory::GetBigIntValue(key)}, &key_schema);
+    }
+    std::vector<std::vector<RID>> batch_results;
+    for (int round = 0; round < 2; round++) {
+      index_info->index_->ScanKeys(keys, &batch_results, txn.get());
+      ASSERT_EQ(keys.size(), batch_results.size());
+      for (const auto &key_results : batch_results) {
+        EXPECT_EQ(1, key_results.size());
+      }
+    }
+  }
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// A linear probing hash index over a table with more tuples than its header page can address twice over is capped
+// at the largest size it can take, instead of failing to build
+TEST(CatalogTest, LinearProbeHashTableIndexOverMaxSize) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  // wide keys keep the table small: few entries of GenericKey<64> fit in a block page
+  using KeyType = GenericKey<64>;
+  using ValueType = RID;
+  const std::size_t max_buckets = HashTableHeaderPage::MaxNumBlocks() * BLOCK_ARRAY_SIZE;
+  const auto num_tuples = static_cast<int32_t>(max_buckets / 2 + 1000);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::BIGINT}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(i)}, &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  auto *index_info = catalog->CreateIndex<KeyType, ValueType, GenericComparator<64>>(
+      txn.get(), "index1", table_name, table_schema, key_schema, key_attrs, 64, HashFunction<KeyType>{},
+      IndexType::LinearProbeHashTable);
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  int32_t count = 0;
+  std::vector<RID> results{};
+  for (auto tuple = table_info->table_->Begin(txn.get()); tuple != table_info->table_->End(); ++tuple) {
+    results.clear();
+    index_info->index_->ScanKey(tuple->KeyFromTuple(table_schema, key_schema, key_attrs), &results, txn.get());
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(tuple->GetRid(), results[0]);
+    count++;
+  }
+  EXPECT_EQ(num_tuples, count);
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// An index is not created when the pages of its table cannot all be read
+TEST(CatalogTest, IndexBuildFailsOnUnreadablePage) {
+  const std::size_t pool_size = 16;
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(pool_size, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::BIGINT}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  const int32_t num_tuples = 5000;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(i), ValueFactory::GetIntegerValue(i)}, &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  // pin every frame, so that table pages no longer in the pool cannot be fetched
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (bpm->NewPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+  ASSERT_EQ(pool_size, pinned.size());
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  auto create_index = [&]() {
+    return catalog->CreateIndex<BigintKeyType, BigintValueType, BigintComparatorType>(
+        txn.get(), "index1", table_name, table_schema, key_schema, key_attrs, BIGINT_SIZE, BigintHashFunctionType{},
+        IndexType::ExtendibleHashTable, 4);
+  };
+  EXPECT_EQ(Catalog::NULL_INDEX_INFO, create_index());
+  EXPECT_EQ(TransactionState::ABORTED, txn->GetState());
+
+  txn->SetState(TransactionState::GROWING);
+  for (page_id_t id : pinned) {
+    bpm->UnpinPage(id, false);
+  }
+  auto *index_info = create_index();
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  std::vector<RID> results{};
+  for (auto tuple = table_info->table_->Begin(txn.get()); tuple != table_info->table_->End(); ++tuple) {
+    results.clear();
+    index_info->index_->ScanKey(tuple->KeyFromTuple(table_schema, key_schema, key_attrs), &results, txn.get());
+    ASSERT_EQ(1, results.size());
+  }
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
+// Prints how long CREATE INDEX takes with 1, 4 and 16 threads. Run it with --gtest_also_run_disabled_tests.
+TEST(CatalogTest, DISABLED_ParallelIndexBuildBenchmark) {
+  auto disk_manager = std::make_unique<DiskManager>("catalog_test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(1 << 12, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  auto txn = std::make_unique<Transaction>(0);
+
+  const std::string table_name{"foobar"};
+  std::vector<Column> columns{{"A", TypeId::BIGINT}, {"B", TypeId::INTEGER}};
+  Schema table_schema{columns};
+  auto *table_info = catalog->CreateTable(txn.get(), table_name, table_schema);
+  const int32_t num_tuples = 1 << 16;
+  for (int32_t i = 0; i < num_tuples; i++) {
+    Tuple tuple{std::vector<Value>{ValueFactory::GetBigIntValue(static_cast<int64_t>(i) * 7919 % num_tuples),
+                                   ValueFactory::GetIntegerValue(i)},
+                &table_schema};
+    RID rid{};
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, txn.get()));
+  }
+
+  std::vector<Column> key_columns{{"A", TypeId::BIGINT}};
+  std::vector<uint32_t> key_attrs{0};
+  Schema key_schema{key_columns};
+  int index_count = 0;
+  for (auto index_type : {IndexType::BPlusTree, IndexType::ExtendibleHashTable}) {
+    for (std::size_t threads : {1, 4, 16}) {
+      auto start = std::chrono::steady_clock::now();
+      catalog->CreateIndex<BigintKeyType, BigintValueType, BigintComparatorType>(
+          txn.get(), "index" + std::to_string(index_count++), table_name, table_schema, key_schema, key_attrs,
+          BIGINT_SIZE, BigintHashFunctionType{}, index_type, threads);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << (index_type == IndexType::BPlusTree ? "B+ tree" : "extendible hash") << ", " << threads
+                << " threads: " << seconds << " s" << std::endl;
+    }
+  }
+
+  remove("catalog_test.db");
+  remove("catalog_test.log");
+}
+
 }  // namespace bustub
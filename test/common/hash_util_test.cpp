@@ -0,0 +1,145 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_util_test.cpp
+//
+// Identification: test/common/hash_util_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "container/hash/hash_function.h"
+#include "gtest/gtest.h"
+#include "murmur3/MurmurHash3.h"
+#include "storage/index/generic_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(HashUtilTest, HashBytesTest) {
+  std::string str(100, 'a');
+  for (size_t i = 0; i < str.size(); i++) {
+    str[i] = static_cast<char>('a' + i % 26);
+  }
+
+  // every prefix length goes through a different code path and must hash differently
+  std::unordered_set<hash_t> hashes;
+  for (size_t len = 0; len <= str.size(); len++) {
+    EXPECT_EQ(HashUtil::HashBytes(str.data(), len), HashUtil::HashBytes(str.data(), len));
+    hashes.insert(HashUtil::HashBytes(str.data(), len));
+  }
+  EXPECT_EQ(str.size() + 1, hashes.size());
+
+  // flipping any single bit changes the hash
+  for (size_t len : {3, 8, 13, 16, 40}) {
+    hash_t base = HashUtil::HashBytes(str.data(), len);
+    for (size_t bit = 0; bit < len * 8; bit++) {
+      std::string flipped = str.substr(0, len);
+      flipped[bit / 8] = static_cast<char>(flipped[bit / 8] ^ (1 << bit % 8));
+      EXPECT_NE(base, HashUtil::HashBytes(flipped.data(), len)) << "len " << len << " bit " << bit;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashUtilTest, TypedHashTest) {
+  // 4-byte and 8-byte keys take the single-word fast path
+  int64_t big = 42;
+  int32_t small = 42;
+  EXPECT_EQ(HashUtil::HashWord(42), HashUtil::Hash(&big));
+  EXPECT_EQ(HashUtil::HashWord(42), HashUtil::Hash(&small));
+
+  // integer values of different widths hash alike
+  Value tiny = ValueFactory::GetTinyIntValue(7);
+  Value integer = ValueFactory::GetIntegerValue(7);
+  Value bigint = ValueFactory::GetBigIntValue(7);
+  EXPECT_EQ(HashUtil::HashValue(&tiny), HashUtil::HashValue(&integer));
+  EXPECT_EQ(HashUtil::HashValue(&integer), HashUtil::HashValue(&bigint));
+
+  Value foo = ValueFactory::GetVarcharValue("foo");
+  Value bar = ValueFactory::GetVarcharValue("bar");
+  EXPECT_NE(HashUtil::HashValue(&foo), HashUtil::HashValue(&bar));
+
+  // combining is order sensitive
+  EXPECT_NE(HashUtil::CombineHashes(1, 2), HashUtil::CombineHashes(2, 1));
+
+  GenericKey<8> key;
+  key.SetFromInteger(42);
+  uint64_t word;
+  memcpy(&word, key.data_, sizeof(word));
+  EXPECT_EQ(HashUtil::HashWord(word), HashFunction<GenericKey<8>>().GetHash(key));
+}
+
+// NOLINTNEXTLINE
+TEST(HashUtilTest, DistributionTest) {
+  // sequential integer keys must spread evenly over the low bits used by the hash tables
+  const uint32_t num_buckets = 1024;
+  const uint32_t num_keys = num_buckets * 64;
+  std::vector<uint32_t> buckets(num_buckets);
+  HashFunction<int> hash_fn;
+  for (uint32_t i = 0; i < num_keys; i++) {
+    buckets[hash_fn.GetHash(static_cast<int>(i)) & (num_buckets - 1)]++;
+  }
+  for (uint32_t count : buckets) {
+    EXPECT_GT(count, 64 / 2);
+    EXPECT_LT(count, 64 * 2);
+  }
+}
+
+// Prints throughput and low-bit collisions of the hash functions. Run it with --gtest_also_run_disabled_tests.
+// NOLINTNEXTLINE
+TEST(HashUtilTest, DISABLED_HashBenchmark) {
+  // the byte-at-a-time hash HashUtil used before
+  auto shift_xor = [](const char *bytes, size_t length) {
+    hash_t hash = length;
+    for (size_t i = 0; i < length; ++i) {
+      hash = ((hash << 5) ^ (hash >> 27)) ^ bytes[i];
+    }
+    return hash;
+  };
+  auto murmur = [](const char *bytes, size_t length) {
+    uint64_t hash[2];
+    murmur3::MurmurHash3_x64_128(bytes, static_cast<int>(length), 0, reinterpret_cast<void *>(&hash));
+    return static_cast<hash_t>(hash[0]);
+  };
+
+  auto run = [](const char *name, auto hash) {
+    const size_t num_keys = 1 << 20;
+    const uint64_t low_bits = (1 << 20) - 1;
+    for (size_t len : {4, 8, 16, 64, 256}) {
+      std::vector<char> buf(len + sizeof(uint64_t));
+      std::unordered_set<uint64_t> slots;
+      hash_t sink = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (uint64_t i = 0; i < num_keys; i++) {
+        memcpy(buf.data(), &i, std::min(len, sizeof(i)));
+        sink ^= hash(buf.data(), len);
+      }
+      auto end = std::chrono::steady_clock::now();
+      for (uint64_t i = 0; i < num_keys; i++) {
+        memcpy(buf.data(), &i, std::min(len, sizeof(i)));
+        slots.insert(hash(buf.data(), len) & low_bits);
+      }
+      double ns = std::chrono::duration<double, std::nano>(end - start).count() / num_keys;
+      // about 1 - 1/e of the slots get used by a uniform hash
+      std::cout << name << " len " << len << ": " << ns << " ns/key, " << slots.size() << "/" << num_keys
+                << " distinct low-20-bit slots (" << sink % 2 << ")" << std::endl;
+    }
+  };
+
+  run("shift-xor", shift_xor);
+  run("murmur3", murmur);
+  run("HashBytes", HashUtil::HashBytes);
+}
+
+}  // namespace bustub
@@ -10,12 +10,16 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iostream>
 #include <thread>  // NOLINT
 #include <vector>
 
 #include "buffer/buffer_pool_manager_instance.h"
 #include "common/logger.h"
 #include "container/hash/extendible_hash_table.h"
+#include "container/hash/linear_probe_hash_table.h"
 #include "gtest/gtest.h"
 #include "murmur3/MurmurHash3.h"
 
@@ -159,4 +163,312 @@ TEST(HashTableTest, SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, BulkLoadTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // bulk load into an empty table
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 20000; i++) {
+    items.emplace_back(i, i);
+  }
+  EXPECT_TRUE(ht.BulkLoad(nullptr, items));
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < 20000; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to load " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // bulk load into a non-empty table falls back to regular inserts
+  items.clear();
+  for (int i = 0; i < 1000; i++) {
+    items.emplace_back(i, 2 * i);
+  }
+  EXPECT_FALSE(ht.BulkLoad(nullptr, items));
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < 1000; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i == 0 ? 1 : 2, res.size());
+  }
+
+  // the loaded table keeps working with regular removes
+  for (int i = 0; i < 20000; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  ht.VerifyIntegrity();
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, LinearProbeSampleTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+
+  // insert a few values
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to insert " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // insert one more value for each key
+  for (int i = 0; i < 5; i++) {
+    if (i == 0) {
+      // duplicate values for the same key are not allowed
+      EXPECT_FALSE(ht.Insert(nullptr, i, 2 * i));
+    } else {
+      EXPECT_TRUE(ht.Insert(nullptr, i, 2 * i));
+    }
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i == 0 ? 1 : 2, res.size());
+  }
+
+  // look for a key that does not exist
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 20, &res));
+  EXPECT_EQ(0, res.size());
+
+  // delete some values
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    if (i == 0) {
+      EXPECT_EQ(0, res.size());
+    } else {
+      EXPECT_EQ(1, res.size());
+      EXPECT_EQ(2 * i, res[0]);
+    }
+  }
+  EXPECT_FALSE(ht.Remove(nullptr, 0, 0));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, LinearProbeResizeTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+  EXPECT_EQ(10, ht.GetSize());
+
+  // the table grows well past its initial size, migrating incrementally
+  bool saw_resizing = false;
+  for (int i = 0; i < 20000; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    saw_resizing = saw_resizing || ht.IsResizing();
+    if (i % 97 == 0) {
+      // all values stay visible while entries are spread across both layouts
+      for (int j = 0; j <= i; j += 7) {
+        std::vector<int> res;
+        ht.GetValue(nullptr, j, &res);
+        ASSERT_EQ(1, res.size()) << "Failed to find " << j << " after inserting " << i << std::endl;
+        EXPECT_EQ(j, res[0]);
+      }
+    }
+  }
+  EXPECT_TRUE(saw_resizing);
+  EXPECT_GE(ht.GetSize(), 20000);
+
+  // removes also drive the migration and find entries in either layout
+  for (int i = 0; i < 20000; i += 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int i = 0; i < 20000; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i % 2, res.size());
+  }
+
+  // an explicit resize keeps all entries
+  ht.Resize(ht.GetSize());
+  EXPECT_TRUE(ht.IsResizing());
+  for (int i = 1; i < 20000; i += 2) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size());
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  EXPECT_FALSE(ht.IsResizing());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, GetValuesTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  for (int i = 0; i < 5000; i++) {
+    ht.Insert(nullptr, i, i);
+    if (i % 3 == 0) {
+      ht.Insert(nullptr, i, -i - 1);
+    }
+  }
+
+  // a batch with repeated keys, missing keys and keys spread over many buckets
+  std::vector<int> keys;
+  for (int i = 0; i < 6000; i += 7) {
+    keys.push_back(i);
+    keys.push_back(i);
+  }
+  std::vector<std::vector<int>> results;
+  EXPECT_TRUE(ht.GetValues(nullptr, keys, &results));
+  ASSERT_EQ(keys.size(), results.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    std::vector<int> expected;
+    ht.GetValue(nullptr, keys[i], &expected);
+    std::sort(expected.begin(), expected.end());
+    std::sort(results[i].begin(), results[i].end());
+    EXPECT_EQ(expected, results[i]) << "key " << keys[i];
+    EXPECT_EQ(keys[i] >= 5000 ? 0 : (keys[i] % 3 == 0 ? 2 : 1), results[i].size());
+  }
+
+  // nothing found
+  EXPECT_FALSE(ht.GetValues(nullptr, {-1, 10000}, &results));
+  EXPECT_EQ(2, results.size());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, IteratorTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // an empty table has nothing to visit
+  EXPECT_TRUE(ht.Begin().IsEnd());
+
+  const int num_keys = 5000;
+  for (int i = 0; i < num_keys; i++) {
+    ht.Insert(nullptr, i, i);
+  }
+  EXPECT_GT(ht.GetGlobalDepth(), 1);
+
+  // every pair is visited exactly once, even though buckets are shared by directory slots
+  std::vector<int> seen(num_keys);
+  for (auto iter = ht.Begin(); !iter.IsEnd(); ++iter) {
+    EXPECT_EQ((*iter).first, (*iter).second);
+    seen[(*iter).first]++;
+  }
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_EQ(1, seen[i]) << "key " << i;
+  }
+
+  // partitions can be consumed in parallel and together cover the table exactly once
+  std::vector<int> counts(num_keys);
+  auto partitions = ht.BeginPartitions(4);
+  EXPECT_EQ(4, partitions.size());
+  std::vector<std::thread> threads;
+  std::vector<std::vector<int>> keys(partitions.size());
+  for (size_t i = 0; i < partitions.size(); i++) {
+    threads.emplace_back([&partitions, &keys, i] {
+      for (auto &iter = partitions[i]; !iter.IsEnd(); ++iter) {
+        keys[i].push_back((*iter).first);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto &partition_keys : keys) {
+    for (int key : partition_keys) {
+      counts[key]++;
+    }
+  }
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_EQ(1, counts[i]) << "key " << i;
+  }
+
+  // buckets that merges delete after the iterator is created are skipped, and the buckets left still hold every key
+  // that was not removed; only the first bucket, copied when the iterator was created, can be out of date
+  auto iter = ht.Begin();
+  for (int i = 0; i < num_keys; i++) {
+    if (i % 10 != 0) {
+      ht.Remove(nullptr, i, i);
+    }
+  }
+  std::fill(seen.begin(), seen.end(), 0);
+  int removed_seen = 0;
+  for (; !iter.IsEnd(); ++iter) {
+    seen[(*iter).first]++;
+    removed_seen += (*iter).first % 10 != 0 ? 1 : 0;
+  }
+  for (int i = 0; i < num_keys; i += 10) {
+    EXPECT_EQ(1, seen[i]) << "key " << i;
+  }
+  // at most one stale bucket, i.e. BUCKET_ARRAY_SIZE for <int, int> pairs
+  EXPECT_LE(removed_seen, 4 * PAGE_SIZE / (4 * sizeof(std::pair<int, int>) + 1));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// Prints insert and lookup throughput of both hash table implementations. Run it with
+// --gtest_also_run_disabled_tests.
+// NOLINTNEXTLINE
+TEST(HashTableTest, DISABLED_LinearProbeVsExtendibleBenchmark) {
+  const int num_keys = 100000;
+  auto run = [num_keys](const char *name, auto *ht) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+      ht->Insert(nullptr, i, i);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+      std::vector<int> res;
+      ht->GetValue(nullptr, i, &res);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": insert " << std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count()
+              << " ms, lookup " << std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count() << " ms"
+              << std::endl;
+  };
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(1000, disk_manager);
+  {
+    ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+    run("extendible", &ht);
+  }
+  {
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+    run("linear probe", &ht);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
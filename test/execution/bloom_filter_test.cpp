@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter_test.cpp
+//
+// Identification: test/execution/bloom_filter_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "execution/bloom_filter.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BloomFilterTest, BasicTest) {
+  const int32_t num_keys = 10000;
+  auto hash = [](int32_t i) {
+    Value value = ValueFactory::GetIntegerValue(i);
+    return HashUtil::HashValue(&value);
+  };
+
+  BloomFilter filter(num_keys);
+  for (int32_t i = 0; i < num_keys; i++) {
+    filter.Insert(hash(i));
+  }
+
+  // No false negatives, and about 1% false positives
+  for (int32_t i = 0; i < num_keys; i++) {
+    ASSERT_TRUE(filter.MayContain(hash(i)));
+  }
+  int32_t false_positives = 0;
+  for (int32_t i = num_keys; i < 11 * num_keys; i++) {
+    false_positives += filter.MayContain(hash(i)) ? 1 : 0;
+  }
+  ASSERT_LT(false_positives, 10 * num_keys / 50);
+
+  // An empty filter lets nothing through
+  BloomFilter empty(0);
+  for (int32_t i = 0; i < num_keys; i++) {
+    ASSERT_FALSE(empty.MayContain(hash(i)));
+  }
+}
+
+}  // namespace bustub
@@ -10,20 +10,30 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <fstream>
+#include <functional>
+#include <iostream>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager_instance.h"
 #include "concurrency/transaction_manager.h"
+#include "execution/bloom_filter.h"
+#include "execution/constant_comparison_filter.h"
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/top_n_executor.h"
 #include "execution/expressions/aggregate_value_expression.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
@@ -31,9 +41,13 @@
 #include "execution/plans/delete_plan.h"
 #include "execution/plans/distinct_plan.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/top_n_plan.h"
 #include "execution/plans/update_plan.h"
+#include "execution/tuple_batch.h"
 #include "executor_test_util.h"  // NOLINT
 #include "gtest/gtest.h"
 #include "storage/table/tuple.h"
@@ -46,6 +60,7 @@
  * particular, the tests in this file include:
  *
  * - Sequential Scan
+ * - Index Scan
  * - Insert (Raw)
  * - Insert (Select)
  * - Update
@@ -110,6 +125,142 @@ TEST_F(ExecutorTest, SimpleSeqScanTest) {
   }
 }
 
+// SELECT col_a, col_b FROM test_1 WHERE <col_a or 500> <comparison> <500 or col_a>, with the comparison checked on the
+// tuple bytes in the table pages
+TEST_F(ExecutorTest, SeqScanRawFilterTest) {
+  TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  const Schema &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *const500 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(500));
+  auto *out_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+
+  struct Case {
+    const AbstractExpression *lhs_;
+    const AbstractExpression *rhs_;
+    ComparisonType comp_type_;
+    std::function<bool(int32_t)> keeps_;
+  };
+  std::vector<Case> cases{{col_a, const500, ComparisonType::Equal, [](int32_t a) { return a == 500; }},
+                          {col_a, const500, ComparisonType::NotEqual, [](int32_t a) { return a != 500; }},
+                          {col_a, const500, ComparisonType::GreaterThanOrEqual, [](int32_t a) { return a >= 500; }},
+                          {const500, col_a, ComparisonType::GreaterThan, [](int32_t a) { return 500 > a; }},
+                          {const500, col_a, ComparisonType::LessThanOrEqual, [](int32_t a) { return 500 <= a; }}};
+  for (const auto &test_case : cases) {
+    auto *predicate = MakeComparisonExpression(test_case.lhs_, test_case.rhs_, test_case.comp_type_);
+    ASSERT_NE(MakeConstantComparisonFilter(predicate, &schema), nullptr);
+    SeqScanPlanNode plan{out_schema, predicate, table_info->oid_};
+    std::vector<Tuple> result_set{};
+    GetExecutionEngine()->Execute(&plan, &result_set, GetTxn(), GetExecutorContext());
+
+    // colA is serial, so the expected result is colA = 0 .. TEST1_SIZE - 1 filtered by the comparison
+    std::size_t expected_size = 0;
+    for (uint32_t a = 0; a < TEST1_SIZE; a++) {
+      expected_size += test_case.keeps_(a) ? 1 : 0;
+    }
+    ASSERT_EQ(result_set.size(), expected_size);
+    for (const auto &tuple : result_set) {
+      ASSERT_TRUE(test_case.keeps_(tuple.GetValue(out_schema, out_schema->GetColIdx("colA")).GetAs<int32_t>()));
+    }
+  }
+
+  // A NULL column is left to the predicate, and only column-constant comparisons of the same type become filters
+  auto filter = MakeConstantComparisonFilter(MakeComparisonExpression(col_a, const500, ComparisonType::Equal), &schema);
+  Tuple null_tuple{{ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetIntegerValue(0),
+                    ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(0)},
+                   &schema};
+  ASSERT_EQ(schema.GetColumnCount(), 4);
+  ASSERT_TRUE(filter->Matches(null_tuple.GetData()));
+  ASSERT_EQ(MakeConstantComparisonFilter(MakeComparisonExpression(col_a, col_b, ComparisonType::Equal), &schema),
+            nullptr);
+  ASSERT_EQ(MakeConstantComparisonFilter(
+                MakeComparisonExpression(col_a, MakeConstantValueExpression(ValueFactory::GetBigIntValue(500)),
+                                         ComparisonType::Equal),
+                &schema),
+            nullptr);
+}
+
+// SELECT col_a, col_b FROM test_1 WHERE col_a BETWEEN 100 AND 199 AND col_b < 5 ORDER BY col_a [DESC]
+TEST_F(ExecutorTest, SimpleIndexScanTest) {
+  TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  const Schema &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("a int");
+  auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "index1", "test_1", schema, *key_schema, {0}, 8, HashFunctionType{}, IndexType::BPlusTree);
+
+  // Construct query plans over the key range [100, 199], ascending and descending
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *const5 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(5));
+  auto *predicate = MakeComparisonExpression(col_b, const5, ComparisonType::LessThan);
+  auto *out_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  Tuple low_key{{ValueFactory::GetIntegerValue(100)}, key_schema.get()};
+  Tuple high_key{{ValueFactory::GetIntegerValue(199)}, key_schema.get()};
+
+  for (bool reverse : {false, true}) {
+    IndexScanPlanNode plan{out_schema, predicate, index_info->index_oid_, low_key, high_key, reverse};
+
+    // Execute
+    std::vector<Tuple> result_set{};
+    GetExecutionEngine()->Execute(&plan, &result_set, GetTxn(), GetExecutorContext());
+
+    // Verify: the rows come in index order, within the range, and satisfy the predicate
+    ASSERT_FALSE(result_set.empty());
+    int32_t last = reverse ? 200 : 99;
+    for (const auto &tuple : result_set) {
+      int32_t col_a_value = tuple.GetValue(out_schema, out_schema->GetColIdx("colA")).GetAs<int32_t>();
+      ASSERT_TRUE(reverse ? col_a_value < last : col_a_value > last);
+      ASSERT_TRUE(col_a_value >= 100 && col_a_value <= 199);
+      ASSERT_TRUE(tuple.GetValue(out_schema, out_schema->GetColIdx("colB")).GetAs<int32_t>() < 5);
+      last = col_a_value;
+    }
+  }
+
+  // Without bounds and predicate, the scan returns the whole table
+  IndexScanPlanNode full_plan{out_schema, nullptr, index_info->index_oid_};
+  std::vector<Tuple> result_set{};
+  GetExecutionEngine()->Execute(&full_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), TEST1_SIZE);
+}
+
+// SELECT colA, colB FROM test_1 through a sequential and an index scan, with a Bloom filter of colA in [0, 100)
+// pushed down to them
+TEST_F(ExecutorTest, BloomFilterPushDownTest) {
+  TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  const Schema &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("a int");
+  auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "index1", "test_1", schema, *key_schema, {0}, 8, HashFunctionType{}, IndexType::BPlusTree);
+
+  auto *out_schema = MakeOutputSchema(
+      {{"colB", MakeColumnValueExpression(schema, 0, "colB")}, {"colA", MakeColumnValueExpression(schema, 0, "colA")}});
+  auto filter = std::make_shared<BloomFilter>(100);
+  for (int32_t i = 0; i < 100; i++) {
+    Value value = ValueFactory::GetIntegerValue(i);
+    filter->Insert(HashUtil::HashValue(&value));
+  }
+
+  SeqScanPlanNode seq_plan{out_schema, nullptr, table_info->oid_};
+  IndexScanPlanNode index_plan{out_schema, nullptr, index_info->index_oid_};
+  for (const AbstractPlanNode *plan : std::vector<const AbstractPlanNode *>{&seq_plan, &index_plan}) {
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), plan);
+    ASSERT_TRUE(executor->PushDownBloomFilter(1, filter));
+    executor->Init();
+
+    // Every row in the filter comes out, and few others do
+    std::unordered_set<int32_t> col_as;
+    Tuple tuple;
+    RID rid;
+    while (executor->Next(&tuple, &rid)) {
+      col_as.insert(tuple.GetValue(out_schema, 1).GetAs<int32_t>());
+    }
+    for (int32_t i = 0; i < 100; i++) {
+      ASSERT_EQ(col_as.count(i), 1);
+    }
+    ASSERT_LT(col_as.size(), 150);
+  }
+}
+
 // INSERT INTO empty_table2 VALUES (100, 10), (101, 11), (102, 12)
 TEST_F(ExecutorTest, SimpleRawInsertTest) {
   // Create Values to insert
@@ -416,6 +567,83 @@ TEST_F(ExecutorTest, SimpleNestedLoopJoinTest) {
   ASSERT_EQ(result_set.size(), 100);
 }
 
+// Passes the tuples of a child executor through, counting the calls to Init()
+class InitCountingExecutor : public AbstractExecutor {
+ public:
+  InitCountingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child, std::size_t *init_count)
+      : AbstractExecutor(exec_ctx), child_(std::move(child)), init_count_(init_count) {}
+
+  void Init() override {
+    (*init_count_)++;
+    child_->Init();
+  }
+
+  bool Next(Tuple *tuple, RID *rid) override { return child_->Next(tuple, rid); }
+
+  const Schema *GetOutputSchema() override { return child_->GetOutputSchema(); }
+
+ private:
+  std::unique_ptr<AbstractExecutor> child_;
+  std::size_t *init_count_;
+};
+
+// SELECT l.colA, r.colA FROM left_table l JOIN right_table r ON l.colB = r.colA, with blocks of different sizes
+TEST_F(ExecutorTest, BlockNestedLoopJoinTest) {
+  const int32_t left_size = 3000;
+  const int32_t right_size = 200;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *left_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "left_table", table_schema);
+  auto *right_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "right_table", table_schema);
+  std::vector<int32_t> expected;
+  for (int32_t i = 0; i < left_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % 300)}, &left_info->schema_);
+    ASSERT_TRUE(left_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    if (i % 300 < right_size) {
+      expected.push_back(i);
+    }
+  }
+  for (int32_t i = 0; i < right_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i)}, &right_info->schema_);
+    ASSERT_TRUE(right_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, left_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, right_info->oid_};
+  auto *left_b = MakeColumnValueExpression(*scan_schema, 0, "colB");
+  auto *right_a = MakeColumnValueExpression(*scan_schema, 1, "colA");
+  auto *join_schema =
+      MakeOutputSchema({{"leftA", MakeColumnValueExpression(*scan_schema, 0, "colA")}, {"rightA", right_a}});
+  auto *predicate = MakeComparisonExpression(left_b, right_a, ComparisonType::Equal);
+
+  // a left tuple takes 8 bytes, so a page holds 512 of them: a block of one page makes 6 blocks, 16 pages make 1
+  const std::vector<std::pair<std::size_t, std::size_t>> configs{{1, 6}, {NLJ_BLOCK_PAGES, 1}};
+  for (auto [block_pages, blocks] : configs) {
+    NestedLoopJoinPlanNode join_plan{join_schema, {&left_plan, &right_plan}, predicate, block_pages};
+    std::size_t right_inits = 0;
+    NestedLoopJoinExecutor executor{
+        GetExecutorContext(), &join_plan, ExecutorFactory::CreateExecutor(GetExecutorContext(), &left_plan),
+        std::make_unique<InitCountingExecutor>(GetExecutorContext(),
+                                               ExecutorFactory::CreateExecutor(GetExecutorContext(), &right_plan),
+                                               &right_inits)};
+    executor.Init();
+    std::vector<int32_t> left_as;
+    Tuple tuple;
+    RID rid;
+    while (executor.Next(&tuple, &rid)) {
+      int32_t left_a = tuple.GetValue(join_schema, 0).GetAs<int32_t>();
+      ASSERT_EQ(tuple.GetValue(join_schema, 1).GetAs<int32_t>(), left_a % 300);
+      left_as.push_back(left_a);
+    }
+    std::sort(left_as.begin(), left_as.end());
+    ASSERT_EQ(left_as, expected) << block_pages;
+    ASSERT_EQ(right_inits, blocks) << block_pages;
+  }
+}
+
 // SELECT test_4.colA, test_4.colB, test_6.colA, test_6.colB FROM test_4 JOIN test_6 ON test_4.colA = test_6.colA;
 TEST_F(ExecutorTest, SimpleHashJoinTest) {
   // Construct sequential scan of table test_4
@@ -652,4 +880,481 @@ TEST_F(ExecutorTest, SimpleDistinctTest) {
   ASSERT_TRUE(std::equal(results.cbegin(), results.cend(), expected.cbegin()));
 }
 
+// Runs scans, a filter, a limit, a distinct, an aggregation and a hash join over a table larger than a batch,
+// checking that NextBatch() produces the same tuples as Next()
+TEST_F(ExecutorTest, BatchExecutionTest) {
+  const uint32_t table_size = 3 * TUPLE_BATCH_SIZE - 72;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "batch_table", table_schema);
+  for (uint32_t i = 0; i < table_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % 10)}, &table_info->schema_);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  const auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+
+  // The sorted rows produced by the executor of plan, drained by Next() or by NextBatch()
+  auto execute = [&](const AbstractPlanNode *plan, bool batched) {
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), plan);
+    executor->Init();
+    std::vector<std::vector<int32_t>> rows;
+    auto add_row = [&](const Tuple &tuple) {
+      std::vector<int32_t> row;
+      for (uint32_t i = 0; i < plan->OutputSchema()->GetColumnCount(); i++) {
+        row.push_back(tuple.GetValue(plan->OutputSchema(), i).GetAs<int32_t>());
+      }
+      rows.push_back(std::move(row));
+    };
+    if (batched) {
+      TupleBatch batch;
+      while (executor->NextBatch(&batch)) {
+        EXPECT_FALSE(batch.IsEmpty());
+        for (uint32_t row : batch.GetSelection()) {
+          add_row(batch.GetTuple(row));
+        }
+      }
+    } else {
+      Tuple tuple;
+      RID rid;
+      while (executor->Next(&tuple, &rid)) {
+        add_row(tuple);
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+  auto check = [&](const AbstractPlanNode *plan, std::size_t expected_size) {
+    auto rows = execute(plan, false);
+    ASSERT_EQ(rows.size(), expected_size);
+    ASSERT_EQ(execute(plan, true), rows);
+  };
+
+  // SELECT colA, colB FROM batch_table WHERE colA >= 500
+  auto *predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(ValueFactory::GetIntegerValue(500)),
+                                             ComparisonType::GreaterThanOrEqual);
+  SeqScanPlanNode filter_plan{scan_schema, predicate, table_info->oid_};
+  check(&filter_plan, table_size - 500);
+
+  // SELECT colA, colB FROM batch_table LIMIT 1500
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  LimitPlanNode limit_plan{scan_schema, &scan_plan, 1500};
+  check(&limit_plan, 1500);
+
+  // SELECT DISTINCT colB FROM batch_table
+  auto *col_b_schema = MakeOutputSchema({{"colB", col_b}});
+  SeqScanPlanNode col_b_scan_plan{col_b_schema, nullptr, table_info->oid_};
+  DistinctPlanNode distinct_plan{col_b_schema, &col_b_scan_plan};
+  check(&distinct_plan, 10);
+
+  // SELECT colB, COUNT(colA) FROM batch_table GROUP BY colB
+  auto *agg_schema = MakeOutputSchema(
+      {{"colB", MakeAggregateValueExpression(true, 0)}, {"countA", MakeAggregateValueExpression(false, 0)}});
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               nullptr,
+                               {MakeColumnValueExpression(*scan_schema, 0, "colB")},
+                               {MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                               {AggregationType::CountAggregate}};
+  check(&agg_plan, 10);
+  ASSERT_EQ(execute(&agg_plan, true)[0], (std::vector<int32_t>{0, static_cast<int32_t>(table_size / 10)}));
+
+  // SELECT l.colA, r.colB FROM batch_table l JOIN batch_table r ON l.colA = r.colA
+  SeqScanPlanNode right_scan_plan{scan_schema, nullptr, table_info->oid_};
+  auto *left_col_a = MakeColumnValueExpression(*scan_schema, 0, "colA");
+  auto *right_col_a = MakeColumnValueExpression(*scan_schema, 1, "colA");
+  auto *join_schema =
+      MakeOutputSchema({{"colA", left_col_a}, {"colB", MakeColumnValueExpression(*scan_schema, 1, "colB")}});
+  HashJoinPlanNode join_plan{join_schema, {&scan_plan, &right_scan_plan}, left_col_a, right_col_a};
+  check(&join_plan, table_size);
+}
+
+// SELECT colA, colB FROM parallel_table WHERE colA >= 1234, and
+// SELECT colB, COUNT(colA), SUM(colA) FROM parallel_table GROUP BY colB, scanning the table with several threads
+TEST_F(ExecutorTest, ParallelSeqScanTest) {
+  const int32_t table_size = 10000;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "parallel_table", table_schema);
+  for (int32_t i = 0; i < table_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % 7)}, &table_info->schema_);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  std::vector<page_id_t> page_ids;
+  ASSERT_TRUE(table_info->table_->GetPageIds(&page_ids));
+  ASSERT_GT(page_ids.size(), 4 * static_cast<std::size_t>(MORSEL_SIZE));
+
+  const auto &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *scan_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  auto *predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(ValueFactory::GetIntegerValue(1234)),
+                                             ComparisonType::GreaterThanOrEqual);
+  SeqScanPlanNode filter_plan{scan_schema, predicate, table_info->oid_};
+
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  auto *agg_schema = MakeOutputSchema({{"colB", MakeAggregateValueExpression(true, 0)},
+                                       {"countA", MakeAggregateValueExpression(false, 0)},
+                                       {"sumA", MakeAggregateValueExpression(false, 1)}});
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               nullptr,
+                               {MakeColumnValueExpression(*scan_schema, 0, "colB")},
+                               {MakeColumnValueExpression(*scan_schema, 0, "colA"),
+                                MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                               {AggregationType::CountAggregate, AggregationType::SumAggregate}};
+
+  for (std::size_t parallelism : {1, 4}) {
+    GetExecutorContext()->SetParallelism(parallelism);
+
+    // The results of a parallel scan come in no particular order
+    std::vector<Tuple> result_set{};
+    GetExecutionEngine()->Execute(&filter_plan, &result_set, GetTxn(), GetExecutorContext());
+    std::vector<int32_t> col_as;
+    for (const auto &tuple : result_set) {
+      int32_t a = tuple.GetValue(scan_schema, 0).GetAs<int32_t>();
+      ASSERT_EQ(tuple.GetValue(scan_schema, 1).GetAs<int32_t>(), a % 7);
+      col_as.push_back(a);
+    }
+    std::sort(col_as.begin(), col_as.end());
+    std::vector<int32_t> expected(table_size - 1234);
+    std::iota(expected.begin(), expected.end(), 1234);
+    ASSERT_EQ(col_as, expected) << parallelism;
+
+    result_set.clear();
+    GetExecutionEngine()->Execute(&agg_plan, &result_set, GetTxn(), GetExecutorContext());
+    ASSERT_EQ(result_set.size(), 7);
+    for (const auto &tuple : result_set) {
+      int32_t b = tuple.GetValue(agg_schema, 0).GetAs<int32_t>();
+      int32_t count = 0;
+      int32_t sum = 0;
+      for (int32_t a = b; a < table_size; a += 7) {
+        count++;
+        sum += a;
+      }
+      ASSERT_EQ(tuple.GetValue(agg_schema, 1).GetAs<int32_t>(), count) << parallelism;
+      ASSERT_EQ(tuple.GetValue(agg_schema, 2).GetAs<int32_t>(), sum) << parallelism;
+    }
+  }
+
+  // A morsel whose pages cannot be fetched fails the scan instead of silently dropping its tuples
+  GetExecutorContext()->SetParallelism(4);
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+  executor->Init();
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (GetBPM()->NewPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+  auto drain = [&]() {
+    TupleBatch batch;
+    while (executor->NextBatch(&batch)) {
+    }
+  };
+  EXPECT_THROW(drain(), Exception);
+  for (page_id_t id : pinned) {
+    GetBPM()->UnpinPage(id, false);
+  }
+}
+
+// SELECT l.colA, r.colA FROM left_table l JOIN right_table r ON l.colB = r.colB under memory budgets that keep the
+// whole build side, a part of it and none of it in memory, and as a parallel radix join, pulling the output both a
+// tuple and a batch at a time.
+TEST_F(ExecutorTest, HashJoinSpillTest) {
+  const int32_t left_size = 20000;
+  const int32_t right_size = 5000;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *left_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "left_table", table_schema);
+  auto *right_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "right_table", table_schema);
+  for (int32_t i = 0; i < left_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % right_size)}, &left_info->schema_);
+    ASSERT_TRUE(left_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  for (int32_t i = 0; i < right_size; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i)}, &right_info->schema_);
+    ASSERT_TRUE(right_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, left_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, right_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"leftA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"rightA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  HashJoinPlanNode join_plan{join_schema,
+                             {&left_plan, &right_plan},
+                             MakeColumnValueExpression(*scan_schema, 0, "colB"),
+                             MakeColumnValueExpression(*scan_schema, 1, "colB")};
+
+  std::vector<int32_t> expected(left_size);
+  std::iota(expected.begin(), expected.end(), 0);
+  auto check = [&](const std::vector<Tuple> &result_set, std::size_t budget) {
+    std::vector<int32_t> left_as;
+    for (const auto &tuple : result_set) {
+      int32_t left_a = tuple.GetValue(join_schema, 0).GetAs<int32_t>();
+      ASSERT_EQ(tuple.GetValue(join_schema, 1).GetAs<int32_t>(), left_a % right_size) << budget;
+      left_as.push_back(left_a);
+    }
+    std::sort(left_as.begin(), left_as.end());
+    ASSERT_EQ(left_as, expected) << budget;
+  };
+
+  const std::vector<std::pair<std::size_t, std::size_t>> configs{{0, 1}, {256 * 1024, 1}, {1, 1}, {0, 4}};
+  for (auto [budget, parallelism] : configs) {
+    GetExecutorContext()->SetMemoryBudget(budget);
+    GetExecutorContext()->SetParallelism(parallelism);
+
+    std::vector<Tuple> result_set{};
+    GetExecutionEngine()->Execute(&join_plan, &result_set, GetTxn(), GetExecutorContext());
+    check(result_set, budget);
+
+    result_set.clear();
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+    executor->Init();
+    Tuple tuple;
+    RID rid;
+    while (executor->Next(&tuple, &rid)) {
+      result_set.push_back(tuple);
+    }
+    check(result_set, budget);
+  }
+  GetExecutorContext()->SetMemoryBudget(0);
+  GetExecutorContext()->SetParallelism(1);
+}
+
+// SELECT colA, colB, colC FROM sort_table ORDER BY colB, colC DESC, colA, in memory and spilled to sorted runs
+TEST_F(ExecutorTest, SortTest) {
+  const int32_t table_size = 3000;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER),
+                       Column("colC", TypeId::VARCHAR, 16)}};
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "sort_table", table_schema);
+  std::vector<std::tuple<int32_t, int32_t, std::string>> expected;
+  for (int32_t i = 0; i < table_size; i++) {
+    // negative values of colB and a colC that is a prefix of another check the key encoding
+    int32_t col_b = (i * 7919) % 101 - 50;
+    std::string col_c = std::string(i % 3, 'x') + std::to_string(i % 7);
+    if (i % 11 == 0) {
+      col_c = "x";
+    }
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(col_b),
+                 ValueFactory::GetVarcharValue(col_c)},
+                &table_info->schema_);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    expected.emplace_back(col_b, i, col_c);
+  }
+  std::sort(expected.begin(), expected.end(), [](const auto &a, const auto &b) {
+    if (std::get<0>(a) != std::get<0>(b)) {
+      return std::get<0>(a) < std::get<0>(b);
+    }
+    if (std::get<2>(a) != std::get<2>(b)) {
+      return std::get<2>(a) > std::get<2>(b);
+    }
+    return std::get<1>(a) < std::get<1>(b);
+  });
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")},
+                                        {"colC", MakeColumnValueExpression(table_schema, 0, "colC")}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  SortPlanNode sort_plan{scan_schema,
+                         &scan_plan,
+                         {{OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colB")},
+                          {OrderByType::Desc, MakeColumnValueExpression(*scan_schema, 0, "colC")},
+                          {OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colA")}}};
+
+  auto check = [&](const std::vector<Tuple> &result_set, std::size_t budget) {
+    ASSERT_EQ(result_set.size(), expected.size()) << budget;
+    for (std::size_t i = 0; i < result_set.size(); i++) {
+      ASSERT_EQ(result_set[i].GetValue(scan_schema, 1).GetAs<int32_t>(), std::get<0>(expected[i])) << budget;
+      ASSERT_EQ(result_set[i].GetValue(scan_schema, 0).GetAs<int32_t>(), std::get<1>(expected[i])) << budget;
+      ASSERT_EQ(result_set[i].GetValue(scan_schema, 2).ToString(), std::get<2>(expected[i])) << budget;
+    }
+  };
+
+  // no spilling, a few runs, and a run per tuple
+  for (std::size_t budget : {0, 64 * 1024, 1}) {
+    GetExecutorContext()->SetMemoryBudget(budget);
+
+    std::vector<Tuple> result_set{};
+    GetExecutionEngine()->Execute(&sort_plan, &result_set, GetTxn(), GetExecutorContext());
+    check(result_set, budget);
+
+    result_set.clear();
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &sort_plan);
+    executor->Init();
+    Tuple tuple;
+    RID rid;
+    while (executor->Next(&tuple, &rid)) {
+      result_set.push_back(tuple);
+    }
+    check(result_set, budget);
+  }
+  GetExecutorContext()->SetMemoryBudget(0);
+}
+
+// SELECT colA, colB FROM top_n_table ORDER BY colB DESC, colA LIMIT n, which runs as a top-n
+TEST_F(ExecutorTest, TopNTest) {
+  const int32_t table_size = 3000;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "top_n_table", table_schema);
+  std::vector<std::pair<int32_t, int32_t>> expected;
+  for (int32_t i = 0; i < table_size; i++) {
+    int32_t col_b = (i * 7919) % 101 - 50;
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(col_b)}, &table_info->schema_);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    expected.emplace_back(-col_b, i);
+  }
+  std::sort(expected.begin(), expected.end());
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  std::vector<std::pair<OrderByType, const AbstractExpression *>> order_bys{
+      {OrderByType::Desc, MakeColumnValueExpression(*scan_schema, 0, "colB")},
+      {OrderByType::Asc, MakeColumnValueExpression(*scan_schema, 0, "colA")}};
+  SortPlanNode sort_plan{scan_schema, &scan_plan, order_bys};
+
+  auto check = [&](const std::vector<Tuple> &result_set, std::size_t n) {
+    ASSERT_EQ(result_set.size(), std::min<std::size_t>(n, table_size));
+    for (std::size_t i = 0; i < result_set.size(); i++) {
+      ASSERT_EQ(result_set[i].GetValue(scan_schema, 0).GetAs<int32_t>(), expected[i].second) << n;
+      ASSERT_EQ(result_set[i].GetValue(scan_schema, 1).GetAs<int32_t>(), -expected[i].first) << n;
+    }
+  };
+
+  for (std::size_t n : {0, 1, 10, 2000, 5000}) {
+    LimitPlanNode limit_plan{scan_schema, &sort_plan, n};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &limit_plan);
+    ASSERT_NE(dynamic_cast<TopNExecutor *>(executor.get()), nullptr);
+    executor->Init();
+    std::vector<Tuple> result_set{};
+    Tuple tuple;
+    RID rid;
+    while (executor->Next(&tuple, &rid)) {
+      result_set.push_back(tuple);
+    }
+    check(result_set, n);
+
+    TopNPlanNode top_n_plan{scan_schema, &scan_plan, order_bys, n};
+    result_set.clear();
+    GetExecutionEngine()->Execute(&top_n_plan, &result_set, GetTxn(), GetExecutorContext());
+    check(result_set, n);
+  }
+}
+
+// Resident set size of this process, in bytes
+static std::size_t ResidentSetSize() {
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  statm >> size >> resident;
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// SELECT l.colA, r.colA FROM left_table l JOIN right_table r ON l.colB = r.colB, where every row has the same colB,
+// for growing right tables, printing how much the resident memory grows while the join runs.
+// Run it with --gtest_also_run_disabled_tests.
+TEST_F(ExecutorTest, DISABLED_HashJoinOutputMemoryBenchmark) {
+  const int32_t left_size = 100;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *left_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "left_table", table_schema);
+  auto *right_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "right_table", table_schema);
+  auto insert = [&](TableInfo *table_info, int32_t from, int32_t to) {
+    for (int32_t i = from; i < to; i++) {
+      RID rid;
+      Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(0)}, &table_info->schema_);
+      ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    }
+  };
+  insert(left_info, 0, left_size);
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, left_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, right_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"leftA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"rightA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  HashJoinPlanNode join_plan{join_schema,
+                             {&left_plan, &right_plan},
+                             MakeColumnValueExpression(*scan_schema, 0, "colB"),
+                             MakeColumnValueExpression(*scan_schema, 1, "colB")};
+
+  int32_t right_size = 0;
+  for (int32_t target_size : {100, 1000, 10000}) {
+    insert(right_info, right_size, target_size);
+    right_size = target_size;
+
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+    std::size_t base_rss = ResidentSetSize();
+    std::size_t peak_rss = base_rss;
+    auto start = std::chrono::steady_clock::now();
+    executor->Init();
+    Tuple tuple;
+    RID rid;
+    std::size_t num_rows = 0;
+    while (executor->Next(&tuple, &rid)) {
+      if (++num_rows % 4096 == 0) {
+        peak_rss = std::max(peak_rss, ResidentSetSize());
+      }
+    }
+    peak_rss = std::max(peak_rss, ResidentSetSize());
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(num_rows, static_cast<std::size_t>(left_size) * right_size);
+    std::cout << num_rows << " output rows: " << ms << " ms, resident memory grew by " << (peak_rss - base_rss) / 1024
+              << " KiB" << std::endl;
+  }
+}
+
+// SELECT l.colA, r.colA FROM left_table l JOIN right_table r ON l.colA = r.colB with the unordered_map hash join and
+// the radix join, printing how long each takes. Run it with --gtest_also_run_disabled_tests.
+TEST_F(ExecutorTest, DISABLED_RadixHashJoinBenchmark) {
+  const int32_t left_size = 10000;
+  const int32_t right_size = 50000;
+  Schema table_schema{{Column("colA", TypeId::INTEGER), Column("colB", TypeId::INTEGER)}};
+  auto *left_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "left_table", table_schema);
+  auto *right_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "right_table", table_schema);
+  for (int32_t i = 0; i < right_size; i++) {
+    RID rid;
+    if (i < left_size) {
+      Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(0)}, &left_info->schema_);
+      ASSERT_TRUE(left_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    }
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % left_size)}, &right_info->schema_);
+    ASSERT_TRUE(right_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto *scan_schema = MakeOutputSchema({{"colA", MakeColumnValueExpression(table_schema, 0, "colA")},
+                                        {"colB", MakeColumnValueExpression(table_schema, 0, "colB")}});
+  SeqScanPlanNode left_plan{scan_schema, nullptr, left_info->oid_};
+  SeqScanPlanNode right_plan{scan_schema, nullptr, right_info->oid_};
+  auto *join_schema = MakeOutputSchema({{"leftA", MakeColumnValueExpression(*scan_schema, 0, "colA")},
+                                        {"rightA", MakeColumnValueExpression(*scan_schema, 1, "colA")}});
+  HashJoinPlanNode join_plan{join_schema,
+                             {&left_plan, &right_plan},
+                             MakeColumnValueExpression(*scan_schema, 0, "colA"),
+                             MakeColumnValueExpression(*scan_schema, 1, "colB")};
+
+  for (std::size_t parallelism : {1, 4}) {
+    GetExecutorContext()->SetParallelism(parallelism);
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &join_plan);
+    auto start = std::chrono::steady_clock::now();
+    executor->Init();
+    TupleBatch batch;
+    std::size_t num_rows = 0;
+    while (executor->NextBatch(&batch)) {
+      num_rows += batch.Size();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(num_rows, static_cast<std::size_t>(right_size));
+    std::cout << (parallelism == 1 ? "unordered_map" : "radix") << " join, parallelism " << parallelism << ": " << ms
+              << " ms" << std::endl;
+  }
+}
+
 }  // namespace bustub
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// radix_join_test.cpp
+//
+// Identification: test/execution/radix_join_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "execution/radix_join.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(RadixJoinTest, JoinTest) {
+  std::vector<int32_t> left_keys;
+  std::vector<int32_t> right_keys;
+  for (int32_t i = 0; i < 3000; i++) {
+    left_keys.push_back(i % 700);
+  }
+  for (int32_t i = 0; i < 2000; i++) {
+    right_keys.push_back(i % 1000);
+  }
+
+  // Keys 2k and 2k + 1 hash alike, so the joins have to compare the keys too
+  auto make_entries = [](const std::vector<int32_t> &keys) {
+    std::vector<RadixJoin::Entry> entries;
+    for (uint32_t i = 0; i < keys.size(); i++) {
+      entries.push_back({static_cast<hash_t>(keys[i] / 2) * 0x9e3779b97f4a7c15ULL, i});
+    }
+    return entries;
+  };
+  auto equal = [&](uint32_t left_idx, uint32_t right_idx) { return left_keys[left_idx] == right_keys[right_idx]; };
+
+  RadixJoin::Matches expected;
+  for (uint32_t l = 0; l < left_keys.size(); l++) {
+    for (uint32_t r = 0; r < right_keys.size(); r++) {
+      if (left_keys[l] == right_keys[r]) {
+        expected.emplace_back(l, r);
+      }
+    }
+  }
+
+  // One partition, one pass, and several passes, on one thread and on several
+  for (std::size_t partition_entries : {10000, 500, 4}) {
+    for (std::size_t parallelism : {1, 3}) {
+      RadixJoin join(parallelism, partition_entries);
+      auto partitions = join.Join(make_entries(left_keys), make_entries(right_keys), equal);
+      RadixJoin::Matches matches;
+      for (const auto &partition : partitions) {
+        matches.insert(matches.end(), partition.begin(), partition.end());
+      }
+      std::sort(matches.begin(), matches.end());
+      ASSERT_EQ(matches, expected) << partition_entries << " " << parallelism;
+
+      // the same partitions joined a couple at a time
+      join.Partition(make_entries(left_keys), make_entries(right_keys));
+      matches.clear();
+      for (std::size_t first = 0; first < join.GetPartitionCount(); first += 2) {
+        join.JoinPartitions(first, std::min<std::size_t>(2, join.GetPartitionCount() - first), equal, &partitions);
+        for (const auto &partition : partitions) {
+          matches.insert(matches.end(), partition.begin(), partition.end());
+        }
+      }
+      std::sort(matches.begin(), matches.end());
+      ASSERT_EQ(matches, expected) << partition_entries << " " << parallelism;
+    }
+  }
+}
+
+}  // namespace bustub
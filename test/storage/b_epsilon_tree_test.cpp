@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_epsilon_tree_test.cpp
+//
+// Identification: test/storage/b_epsilon_tree_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_epsilon_tree.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/page/header_page.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BEpsilonTreeTest, InsertLookupRemoveTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(64, disk_manager);
+  page_id_t page_id;
+  auto *header_page = static_cast<HeaderPage *>(bpm->NewPage(&page_id));
+  header_page->Init();
+  GenericComparator<8> comparator(nullptr);
+  // tiny pages, so that buffers fill up and pages split at every level
+  BEpsilonTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 8, 4, 6);
+
+  auto key_of = [](int64_t value) {
+    GenericKey<8> key;
+    key.SetFromInteger(value);
+    return key;
+  };
+  auto check = [&](const std::map<int64_t, RID> &expected) {
+    std::vector<std::pair<GenericKey<8>, RID>> entries;
+    tree.GetRange(key_of(-1), key_of(1 << 20), &entries);
+    ASSERT_EQ(expected.size(), entries.size());
+    auto it = expected.begin();
+    for (const auto &entry : entries) {
+      ASSERT_EQ(it->first, entry.first.ToString());
+      ASSERT_EQ(it->second, entry.second);
+      ++it;
+    }
+    // a range in the middle, and point lookups of present and missing keys
+    entries.clear();
+    tree.GetRange(key_of(1000), key_of(1999), &entries);
+    EXPECT_EQ(std::distance(expected.lower_bound(1000), expected.lower_bound(2000)), entries.size());
+    for (int64_t value = 0; value < 4000; value += 37) {
+      std::vector<RID> rids;
+      auto found = expected.find(value);
+      ASSERT_EQ(found != expected.end(), tree.GetValue(key_of(value), &rids)) << value;
+      if (found != expected.end()) {
+        ASSERT_EQ(found->second, rids[0]);
+      }
+    }
+  };
+
+  std::mt19937 rng(0);
+  std::map<int64_t, RID> expected;
+  for (int round = 0; round < 4; round++) {
+    // mostly inserts and overwrites, then mostly removes
+    for (int i = 0; i < 5000; i++) {
+      int64_t value = rng() % 4000;
+      if (static_cast<int>(rng() % 4) < (round % 2 == 0 ? 1 : 3)) {
+        tree.Remove(key_of(value));
+        expected.erase(value);
+      } else {
+        RID rid(round, i);
+        tree.Insert(key_of(value), rid);
+        expected[value] = rid;
+      }
+    }
+    check(expected);
+  }
+
+  // removing every key leaves nothing to find
+  for (int64_t value = 0; value < 4000; value++) {
+    tree.Remove(key_of(value));
+  }
+  expected.clear();
+  check(expected);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+  remove("test.db");
+  remove("test.log");
+}
+
+// Compares random inserts into a B+ tree and a B-epsilon tree whose pages do not all fit into the buffer pool:
+// insert throughput and pages written to disk. Run it with --gtest_also_run_disabled_tests.
+// NOLINTNEXTLINE
+TEST(BEpsilonTreeTest, DISABLED_RandomInsertBenchmark) {
+  const int num_keys = 1 << 18;
+  std::vector<int64_t> values(num_keys);
+  std::mt19937_64 rng(0);
+  for (auto &value : values) {
+    value = static_cast<int64_t>(rng() >> 1);
+  }
+  GenericComparator<16> comparator(nullptr);
+
+  auto run = [&](const char *name, auto make_tree) {
+    DiskManager disk_manager("test.db");
+    BufferPoolManagerInstance bpm(256, &disk_manager);
+    page_id_t page_id;
+    static_cast<HeaderPage *>(bpm.NewPage(&page_id))->Init();
+    auto tree = make_tree(&bpm);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+      GenericKey<16> key;
+      key.SetFromInteger(values[i]);
+      tree->Insert(key, RID(0, i));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<int64_t>(num_keys / seconds) << " inserts/s, "
+              << disk_manager.GetNumWrites() << " page writes" << std::endl;
+    bpm.UnpinPage(HEADER_PAGE_ID, true);
+  };
+  run("B+ tree", [&](BufferPoolManager *bpm) {
+    return std::make_unique<BPlusTree<GenericKey<16>, RID, GenericComparator<16>>>("tree", bpm, comparator);
+  });
+  run("B-epsilon tree", [&](BufferPoolManager *bpm) {
+    return std::make_unique<BEpsilonTree<GenericKey<16>, RID, GenericComparator<16>>>("tree", bpm, comparator);
+  });
+  remove("test.db");
+  remove("test.log");
+}
+
+}  // namespace bustub
@@ -10,9 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <chrono>  // NOLINT
 #include <cstdio>
 #include <functional>
+#include <iostream>
+#include <random>
 #include <thread>  // NOLINT
 
 #include "buffer/buffer_pool_manager_instance.h"
@@ -100,7 +103,22 @@ void DeleteHelperSplit(BPlusTree<GenericKey<8>, RID, GenericComparator<8>> *tree
   delete transaction;
 }
 
-TEST(BPlusTreeConcurrentTest, DISABLED_InsertTest1) {
+// helper function to look up the keys of one partition
+void LookupHelperSplit(BPlusTree<GenericKey<8>, RID, GenericComparator<8>> *tree, const std::vector<int64_t> &keys,
+                       int total_threads, uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  std::vector<RID> rids;
+  for (auto key : keys) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      rids.clear();
+      index_key.SetFromInteger(key);
+      tree->GetValue(index_key, &rids);
+      EXPECT_EQ(rids.size(), 1);
+    }
+  }
+}
+
+TEST(BPlusTreeConcurrentTest, InsertTest1) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -152,7 +170,7 @@ TEST(BPlusTreeConcurrentTest, DISABLED_InsertTest1) {
   remove("test.log");
 }
 
-TEST(BPlusTreeConcurrentTest, DISABLED_InsertTest2) {
+TEST(BPlusTreeConcurrentTest, InsertTest2) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -203,7 +221,7 @@ TEST(BPlusTreeConcurrentTest, DISABLED_InsertTest2) {
   remove("test.log");
 }
 
-TEST(BPlusTreeConcurrentTest, DISABLED_DeleteTest1) {
+TEST(BPlusTreeConcurrentTest, DeleteTest1) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -245,7 +263,7 @@ TEST(BPlusTreeConcurrentTest, DISABLED_DeleteTest1) {
   remove("test.log");
 }
 
-TEST(BPlusTreeConcurrentTest, DISABLED_DeleteTest2) {
+TEST(BPlusTreeConcurrentTest, DeleteTest2) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -288,7 +306,7 @@ TEST(BPlusTreeConcurrentTest, DISABLED_DeleteTest2) {
   remove("test.log");
 }
 
-TEST(BPlusTreeConcurrentTest, DISABLED_MixTest) {
+TEST(BPlusTreeConcurrentTest, MixTest) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -333,4 +351,150 @@ TEST(BPlusTreeConcurrentTest, DISABLED_MixTest) {
   remove("test.log");
 }
 
+TEST(BPlusTreeConcurrentTest, MixTest2) {
+  // small pages make every thread split and merge all the way up to the root
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(256, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 4);
+
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  const int num_threads = 8;
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= 5000; key++) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+  LaunchParallelTest(num_threads, InsertHelperSplit, &tree, keys, num_threads);
+
+  // remove the even keys while other threads keep reading the odd ones
+  std::vector<int64_t> even_keys;
+  std::vector<int64_t> odd_keys;
+  for (auto key : keys) {
+    (key % 2 == 0 ? even_keys : odd_keys).push_back(key);
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads / 2; i++) {
+    threads.emplace_back(DeleteHelperSplit, &tree, even_keys, num_threads / 2, i);
+    threads.emplace_back(LookupHelperSplit, &tree, odd_keys, num_threads / 2, i);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  int64_t current_key = 1;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key += 2;
+  }
+  EXPECT_EQ(current_key, 5001);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeConcurrentTest, BLinkMixTest) {
+  // readers run without latches while writers split the pages they are reading
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(256, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 4, BPlusTreeProtocol::B_LINK);
+
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  const int num_threads = 8;
+  std::vector<int64_t> even_keys;
+  std::vector<int64_t> odd_keys;
+  for (int64_t key = 1; key <= 5000; key++) {
+    (key % 2 == 0 ? even_keys : odd_keys).push_back(key);
+  }
+  std::shuffle(even_keys.begin(), even_keys.end(), std::mt19937(0));
+  std::shuffle(odd_keys.begin(), odd_keys.end(), std::mt19937(1));
+  InsertHelper(&tree, odd_keys);
+
+  // half of the threads write while the other half look up keys that must stay visible throughout
+  auto run_mixed = [&](auto writer, const std::vector<int64_t> &write_keys, const std::vector<int64_t> &read_keys) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads / 2; i++) {
+      threads.emplace_back(writer, &tree, write_keys, num_threads / 2, i);
+      threads.emplace_back(LookupHelperSplit, &tree, read_keys, num_threads / 2, i);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+  run_mixed(InsertHelperSplit, even_keys, odd_keys);
+  run_mixed(DeleteHelperSplit, odd_keys, even_keys);
+
+  int64_t current_key = 2;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key += 2;
+  }
+  EXPECT_EQ(current_key, 5002);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+// Prints insert, lookup and delete throughput of both protocols for 1 to 32 threads. Run it with --gtest_also_run_disabled_tests.
+TEST(BPlusTreeConcurrentTest, DISABLED_ThroughputBenchmark) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  const int64_t num_keys = 1 << 18;
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= num_keys; key++) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+
+  for (auto protocol : {BPlusTreeProtocol::LATCH_CRABBING, BPlusTreeProtocol::B_LINK}) {
+    std::cout << (protocol == BPlusTreeProtocol::B_LINK ? "B-link" : "latch crabbing") << ":" << std::endl;
+    for (int num_threads : {1, 2, 4, 8, 16, 32}) {
+      DiskManager *disk_manager = new DiskManager("test.db");
+      BufferPoolManager *bpm = new BufferPoolManagerInstance(4096, disk_manager);
+      // about a full page of 16-byte entries at both levels
+      BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 250, 250, protocol);
+      page_id_t page_id;
+      auto header_page = bpm->NewPage(&page_id);
+      (void)header_page;
+
+      auto run = [&](const char *name, auto helper) {
+        auto start = std::chrono::steady_clock::now();
+        LaunchParallelTest(num_threads, helper, &tree, keys, num_threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << num_threads << " threads " << name << ": " << static_cast<int64_t>(num_keys / seconds) << " ops/s"
+                  << std::endl;
+      };
+      run("insert", InsertHelperSplit);
+      run("lookup", LookupHelperSplit);
+      run("delete", DeleteHelperSplit);
+      // B-link removals never free pages
+      EXPECT_EQ(protocol == BPlusTreeProtocol::LATCH_CRABBING, tree.IsEmpty());
+
+      bpm->UnpinPage(HEADER_PAGE_ID, true);
+      delete disk_manager;
+      delete bpm;
+      remove("test.db");
+      remove("test.log");
+    }
+  }
+}
+
 }  // namespace bustub
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <random>
 
 #include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
@@ -20,7 +21,7 @@
 
 namespace bustub {
 
-TEST(BPlusTreeTests, DISABLED_DeleteTest1) {
+TEST(BPlusTreeTests, DeleteTest1) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -98,7 +99,7 @@ TEST(BPlusTreeTests, DISABLED_DeleteTest1) {
   remove("test.log");
 }
 
-TEST(BPlusTreeTests, DISABLED_DeleteTest2) {
+TEST(BPlusTreeTests, DeleteTest2) {
   // create KeyComparator and index schema
   auto key_schema = ParseCreateStatement("a bigint");
   GenericComparator<8> comparator(key_schema.get());
@@ -175,4 +176,157 @@ TEST(BPlusTreeTests, DISABLED_DeleteTest2) {
   remove("test.db");
   remove("test.log");
 }
+
+TEST(BPlusTreeTests, DeleteTest3) {
+  // small pages so that removals keep merging and redistributing on every level
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  RID rid;
+  Transaction *transaction = new Transaction(0);
+
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= 500; key++) {
+    keys.push_back(key);
+  }
+  std::mt19937 gen(0);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  for (auto key : keys) {
+    rid.Set(static_cast<int32_t>(key >> 32), key & 0xFFFFFFFF);
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree.Insert(index_key, rid, transaction));
+  }
+  // duplicates are rejected
+  index_key.SetFromInteger(keys[0]);
+  EXPECT_FALSE(tree.Insert(index_key, rid, transaction));
+
+  // remove the odd keys in random order
+  std::shuffle(keys.begin(), keys.end(), gen);
+  for (auto key : keys) {
+    if (key % 2 == 1) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key, transaction);
+    }
+  }
+
+  std::vector<RID> rids;
+  for (int64_t key = 1; key <= 500; key++) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(key % 2 == 0, tree.GetValue(index_key, &rids)) << key;
+  }
+  int64_t current_key = 2;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    EXPECT_EQ((*iterator).second.GetSlotNum(), current_key);
+    current_key += 2;
+  }
+  EXPECT_EQ(current_key, 502);
+
+  // removing everything leaves an empty tree that can be refilled
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_TRUE(tree.Begin() == tree.End());
+  index_key.SetFromInteger(7);
+  EXPECT_TRUE(tree.Insert(index_key, rid, transaction));
+  EXPECT_FALSE(tree.IsEmpty());
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeTests, RangeScanTest) {
+  // bounded and descending scans follow the leaf links both ways, also after merges
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  for (auto protocol : {BPlusTreeProtocol::LATCH_CRABBING, BPlusTreeProtocol::B_LINK}) {
+    DiskManager *disk_manager = new DiskManager("test.db");
+    BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+    BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3, protocol);
+    GenericKey<8> index_key;
+    RID rid;
+    Transaction *transaction = new Transaction(0);
+
+    page_id_t page_id;
+    auto header_page = bpm->NewPage(&page_id);
+    (void)header_page;
+
+    std::vector<int64_t> keys;
+    for (int64_t key = 1; key <= 500; key++) {
+      keys.push_back(key);
+    }
+    std::mt19937 gen(0);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (auto key : keys) {
+      rid.Set(static_cast<int32_t>(key >> 32), key & 0xFFFFFFFF);
+      index_key.SetFromInteger(key);
+      tree.Insert(index_key, rid, transaction);
+    }
+    for (auto key : keys) {
+      if (key % 3 == 0) {
+        index_key.SetFromInteger(key);
+        tree.Remove(index_key, transaction);
+      }
+    }
+
+    // the keys left in [low, high], in the order a scan should return them
+    auto expected = [](int64_t low, int64_t high, bool reverse) {
+      std::vector<int64_t> result;
+      for (int64_t key = low; key <= high; key++) {
+        if (key % 3 != 0) {
+          result.push_back(key);
+        }
+      }
+      if (reverse) {
+        std::reverse(result.begin(), result.end());
+      }
+      return result;
+    };
+    auto scan = [](auto &&iterator) {
+      std::vector<int64_t> result;
+      for (; !iterator.IsEnd(); ++iterator) {
+        result.push_back((*iterator).second.GetSlotNum());
+      }
+      return result;
+    };
+    auto key = [](int64_t value) {
+      GenericKey<8> index_key;
+      index_key.SetFromInteger(value);
+      return index_key;
+    };
+
+    EXPECT_EQ(expected(1, 500, false), scan(tree.Begin()));
+    EXPECT_EQ(expected(1, 500, true), scan(tree.RBegin()));
+    EXPECT_EQ(expected(100, 200, false), scan(tree.Begin(key(100), key(200))));
+    EXPECT_EQ(expected(100, 200, true), scan(tree.Begin(key(100), key(200), true)));
+    EXPECT_EQ(expected(99, 201, true), scan(tree.Begin(key(99), key(201), true)));
+    EXPECT_EQ(expected(1, 50, false), scan(tree.Begin(std::nullopt, key(50), false, 4)));
+    EXPECT_EQ(expected(450, 500, true), scan(tree.Begin(key(450), std::nullopt, true, 4)));
+    EXPECT_EQ(expected(1, 500, true), scan(tree.Begin(std::nullopt, std::nullopt, true, 8)));
+    EXPECT_TRUE(tree.Begin(key(201), key(200)).IsEnd());
+    EXPECT_TRUE(tree.Begin(key(600), key(700), true).IsEnd());
+
+    bpm->UnpinPage(HEADER_PAGE_ID, true);
+    delete transaction;
+    delete disk_manager;
+    delete bpm;
+    remove("test.db");
+    remove("test.log");
+  }
+}
 }  // namespace bustub
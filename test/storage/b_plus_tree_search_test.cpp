@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_search_test.cpp
+//
+// Identification: test/storage/b_plus_tree_search_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "common/rid.h"
+#include "gtest/gtest.h"
+#include "storage/page/b_plus_tree_search.h"
+
+namespace bustub {
+
+// A comparator that is not GenericComparator, so that it gets the plain binary search
+template <size_t KeySize>
+class PlainComparator : public GenericComparator<KeySize> {
+ public:
+  PlainComparator() : GenericComparator<KeySize>(nullptr) {}
+};
+
+// num_keys distinct sorted keys: integers spread by spread, with random bytes past the first 8 and
+// few distinct integers if ties is set, so that the search has to look past the first 8 bytes
+template <size_t KeySize>
+std::vector<std::pair<GenericKey<KeySize>, RID>> MakeSearchKeys(std::mt19937 *rng, int num_keys, int64_t spread,
+                                                                bool ties) {
+  GenericComparator<KeySize> comparator(nullptr);
+  std::vector<std::pair<GenericKey<KeySize>, RID>> entries(num_keys);
+  for (int i = 0; i < num_keys; i++) {
+    int64_t value = ties ? (*rng)() % 4 : static_cast<int64_t>((*rng)() % (num_keys * spread + 1)) - 1000;
+    entries[i].first.SetFromInteger(value);
+    for (size_t j = sizeof(int64_t); j < KeySize; j++) {
+      entries[i].first.data_[j] = static_cast<char>((*rng)() % 4);
+    }
+    entries[i].second = RID(0, i);
+  }
+  auto less = [&](const auto &a, const auto &b) { return comparator(a.first, b.first) < 0; };
+  std::sort(entries.begin(), entries.end(), less);
+  entries.erase(std::unique(entries.begin(), entries.end(),
+                            [&](const auto &a, const auto &b) { return comparator(a.first, b.first) == 0; }),
+                entries.end());
+  return entries;
+}
+
+template <size_t KeySize>
+void CheckSearch() {
+  using Search = BPlusTreeSearch<GenericKey<KeySize>, RID, GenericComparator<KeySize>>;
+  using PlainSearch = BPlusTreeSearch<GenericKey<KeySize>, RID, PlainComparator<KeySize>>;
+  GenericComparator<KeySize> comparator(nullptr);
+  PlainComparator<KeySize> plain_comparator;
+
+  std::mt19937 rng(KeySize);
+  for (int num_keys : {0, 1, 3, 17, 100, 300}) {
+    for (int64_t spread : {1, 3, 1000}) {
+      for (bool ties : {false, true}) {
+        auto entries = MakeSearchKeys<KeySize>(&rng, num_keys, spread, ties);
+        auto probes = MakeSearchKeys<KeySize>(&rng, 200, spread, ties);
+        for (const auto &entry : entries) {
+          probes.push_back(entry);
+        }
+        int size = static_cast<int>(entries.size());
+        for (const auto &probe : probes) {
+          // the whole array, as on leaf pages, and without the first entry, as on internal pages
+          for (int first : {0, std::min(1, size)}) {
+            ASSERT_EQ(PlainSearch::LowerBound(entries.data(), first, size, probe.first, plain_comparator),
+                      Search::LowerBound(entries.data(), first, size, probe.first, comparator))
+                << KeySize << " " << size << " " << spread << " " << ties;
+            ASSERT_EQ(PlainSearch::UpperBound(entries.data(), first, size, probe.first, plain_comparator),
+                      Search::UpperBound(entries.data(), first, size, probe.first, comparator))
+                << KeySize << " " << size << " " << spread << " " << ties;
+          }
+        }
+      }
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeSearchTest, MatchesBinarySearchTest) {
+  CheckSearch<4>();
+  CheckSearch<8>();
+  CheckSearch<16>();
+  CheckSearch<32>();
+  CheckSearch<64>();
+}
+
+// Prints the cost of a search over a full leaf page with the plain binary search and the specialized one,
+// for each key size. Run it with --gtest_also_run_disabled_tests.
+template <size_t KeySize>
+void BenchmarkSearch() {
+  using Search = BPlusTreeSearch<GenericKey<KeySize>, RID, GenericComparator<KeySize>>;
+  using PlainSearch = BPlusTreeSearch<GenericKey<KeySize>, RID, PlainComparator<KeySize>>;
+  GenericComparator<KeySize> comparator(nullptr);
+  PlainComparator<KeySize> plain_comparator;
+
+  // as many keys as a leaf page holds, many leaves worth so that the pages are not all in cache
+  const int page_size = (PAGE_SIZE - 36 - KeySize) / sizeof(std::pair<GenericKey<KeySize>, RID>);
+  const int num_pages = 4096;
+  std::mt19937 rng(0);
+  std::vector<std::vector<std::pair<GenericKey<KeySize>, RID>>> pages;
+  for (int i = 0; i < num_pages; i++) {
+    pages.push_back(MakeSearchKeys<KeySize>(&rng, page_size, 4, false));
+  }
+  std::vector<std::pair<int, int>> probes(1 << 20);
+  for (auto &probe : probes) {
+    probe.first = rng() % num_pages;
+    probe.second = rng() % pages[probe.first].size();
+  }
+
+  auto time_search = [&](const char *name, auto search) {
+    int64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &[page, index] : probes) {
+      sink += search(pages[page], pages[page][index].first);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "GenericKey<" << KeySize << "> " << name << ": " << ns / probes.size() << " ns/search (" << sink % 2
+              << ")" << std::endl;
+  };
+  time_search("binary search", [&](const auto &entries, const auto &key) {
+    return PlainSearch::LowerBound(entries.data(), 0, entries.size(), key, plain_comparator);
+  });
+  time_search("specialized", [&](const auto &entries, const auto &key) {
+    return Search::LowerBound(entries.data(), 0, entries.size(), key, comparator);
+  });
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeSearchTest, DISABLED_SearchBenchmark) {
+  BenchmarkSearch<4>();
+  BenchmarkSearch<8>();
+  BenchmarkSearch<16>();
+  BenchmarkSearch<32>();
+  BenchmarkSearch<64>();
+}
+
+}  // namespace bustub
@@ -0,0 +1,271 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_varlen_test.cpp
+//
+// Identification: test/storage/b_plus_tree_varlen_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/key_encoder.h"
+#include "storage/index/varlen_b_plus_tree.h"
+#include "storage/page/header_page.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// keys with long shared prefixes and the odd zero byte, as produced by KeyEncoder for composite keys
+std::string RandomVarlenKey(std::mt19937 *rng) {
+  static const char *prefixes[] = {"", "a", "customer/", "customer/emea/", "customer/emea/de/", "order/2021/"};
+  std::string key = prefixes[(*rng)() % 6];
+  size_t length = (*rng)() % 40;
+  for (size_t i = 0; i < length; i++) {
+    key.push_back(static_cast<char>((*rng)() % 4 == 0 ? (*rng)() % 256 : 'a' + (*rng)() % 3));
+  }
+  return key;
+}
+
+// NOLINTNEXTLINE
+TEST(VarlenBPlusTreeTest, InsertLookupRemoveTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(32, disk_manager);
+  page_id_t page_id;
+  auto *header_page = static_cast<HeaderPage *>(bpm->NewPage(&page_id));
+  header_page->Init();
+  VarlenBPlusTree tree("foo_pk", bpm);
+
+  std::mt19937 rng(0);
+  std::map<std::string, RID> expected;
+  for (int i = 0; i < 20000; i++) {
+    std::string key = RandomVarlenKey(&rng);
+    if (i % 1000 == 0) {
+      // a few keys of the maximum length
+      key.resize(VARLEN_KEY_MAX_SIZE, static_cast<char>('a' + i % 3));
+    }
+    RID rid(i, i);
+    bool is_new = expected.emplace(key, rid).second;
+    EXPECT_EQ(is_new, tree.Insert(key, rid));
+  }
+  EXPECT_FALSE(tree.Insert(std::string(VARLEN_KEY_MAX_SIZE + 1, 'a'), RID()));
+
+  std::vector<RID> rids;
+  for (const auto &[key, rid] : expected) {
+    rids.clear();
+    ASSERT_TRUE(tree.GetValue(key, &rids));
+    ASSERT_EQ(rid, rids[0]);
+  }
+  rids.clear();
+  EXPECT_FALSE(tree.GetValue("customer/emea/de/zzz", &rids));
+
+  // full scan and a scan from a key that is not in the tree
+  auto it = expected.begin();
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator, ++it) {
+    ASSERT_EQ(it->first, (*iterator).first);
+    ASSERT_EQ(it->second, (*iterator).second);
+  }
+  EXPECT_EQ(expected.end(), it);
+  it = expected.lower_bound("customer/emea/c");
+  for (auto iterator = tree.Begin("customer/emea/c"); !iterator.IsEnd(); ++iterator, ++it) {
+    ASSERT_EQ(it->first, (*iterator).first);
+  }
+  EXPECT_EQ(expected.end(), it);
+
+  // remove every other key, then the rest, checking what is left along the way
+  std::vector<std::string> keys;
+  for (const auto &entry : expected) {
+    keys.push_back(entry.first);
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    tree.Remove(keys[i]);
+    expected.erase(keys[i]);
+  }
+  tree.Remove("not a key");
+  it = expected.begin();
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator, ++it) {
+    ASSERT_EQ(it->first, (*iterator).first);
+  }
+  EXPECT_EQ(expected.end(), it);
+  for (size_t i = 0; i < keys.size(); i++) {
+    rids.clear();
+    EXPECT_EQ(i % 2 == 1, tree.GetValue(keys[i], &rids));
+  }
+  for (size_t i = 1; i < keys.size(); i += 2) {
+    tree.Remove(keys[i]);
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_TRUE(tree.Begin().IsEnd());
+
+  // the tree starts over once emptied
+  EXPECT_TRUE(tree.Insert("again", RID(1, 1)));
+  rids.clear();
+  EXPECT_TRUE(tree.GetValue("again", &rids));
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+  remove("test.db");
+  remove("test.log");
+}
+
+// NOLINTNEXTLINE
+TEST(VarlenBPlusTreeTest, ConcurrentInsertTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(64, disk_manager);
+  page_id_t page_id;
+  auto *header_page = static_cast<HeaderPage *>(bpm->NewPage(&page_id));
+  header_page->Init();
+  VarlenBPlusTree tree("foo_pk", bpm);
+
+  const int num_threads = 4;
+  const int keys_per_thread = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&tree, t] {
+      for (int i = 0; i < keys_per_thread; i++) {
+        tree.Insert("key/" + std::to_string(i) + "/" + std::to_string(t), RID(t, i));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  int count = 0;
+  std::string last;
+  for (auto iterator = tree.Begin(); !iterator.IsEnd(); ++iterator, ++count) {
+    EXPECT_LT(last, (*iterator).first);
+    last = (*iterator).first;
+  }
+  EXPECT_EQ(num_threads * keys_per_thread, count);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete bpm;
+  delete disk_manager;
+  remove("test.db");
+  remove("test.log");
+}
+
+// the height of the tree recorded as name in the header page
+template <typename InternalPage>
+int TreeHeight(BufferPoolManager *bpm, const std::string &name) {
+  page_id_t page_id;
+  static_cast<HeaderPage *>(bpm->FetchPage(HEADER_PAGE_ID))->GetRootId(name, &page_id);
+  bpm->UnpinPage(HEADER_PAGE_ID, false);
+  int height = 1;
+  while (true) {
+    auto *node = reinterpret_cast<BPlusTreePage *>(bpm->FetchPage(page_id)->GetData());
+    if (node->IsLeafPage()) {
+      bpm->UnpinPage(page_id, false);
+      break;
+    }
+    page_id_t child_page_id = reinterpret_cast<InternalPage *>(node)->ValueAt(0);
+    bpm->UnpinPage(page_id, false);
+    page_id = child_page_id;
+    height++;
+  }
+  return height;
+}
+
+// Compares a B+ tree over 64-byte GenericKeys with the varlen B+ tree on URL-like VARCHAR keys: tree height,
+// pages allocated and lookup throughput. Run it with --gtest_also_run_disabled_tests.
+// NOLINTNEXTLINE
+TEST(VarlenBPlusTreeTest, DISABLED_StringKeyBenchmark) {
+  Schema key_schema{std::vector<Column>{{"url", TypeId::VARCHAR, 60}}};
+  const int num_keys = 1 << 17;
+  std::mt19937 rng(0);
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_keys; i++) {
+    std::string url = "https://www.example.com/catalog/" + std::to_string(rng() % 100) + "/item-" + std::to_string(i);
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetVarcharValue(url)}, &key_schema);
+  }
+
+  auto run = [&](const char *name, auto insert, auto lookup) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+      insert(i);
+    }
+    double insert_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_keys; i++) {
+      lookup((i * 7919) % num_keys);
+    }
+    double lookup_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << static_cast<int64_t>(num_keys / insert_seconds) << " inserts/s, "
+              << static_cast<int64_t>(num_keys / lookup_seconds) << " lookups/s";
+  };
+
+  {
+    DiskManager disk_manager("test.db");
+    BufferPoolManagerInstance bpm(1 << 14, &disk_manager);
+    page_id_t page_id;
+    static_cast<HeaderPage *>(bpm.NewPage(&page_id))->Init();
+    GenericComparator<64> comparator(&key_schema);
+    BPlusTree<GenericKey<64>, RID, GenericComparator<64>> tree("fixed", &bpm, comparator);
+    std::vector<RID> rids;
+    run(
+        "GenericKey<64>",
+        [&](int i) {
+          GenericKey<64> key;
+          key.SetFromKey(tuples[i], &key_schema);
+          tree.Insert(key, RID(0, i));
+        },
+        [&](int i) {
+          GenericKey<64> key;
+          key.SetFromKey(tuples[i], &key_schema);
+          rids.clear();
+          tree.GetValue(key, &rids);
+        });
+    page_id_t next_page_id;
+    bpm.UnpinPage(bpm.NewPage(&next_page_id)->GetPageId(), false);
+    std::cout << ", height " << TreeHeight<BPlusTreeInternalPage<GenericKey<64>, page_id_t, GenericComparator<64>>>(&bpm, "fixed")
+              << ", " << next_page_id << " pages" << std::endl;
+    bpm.UnpinPage(HEADER_PAGE_ID, true);
+  }
+
+  {
+    DiskManager disk_manager("test.db");
+    BufferPoolManagerInstance bpm(1 << 14, &disk_manager);
+    page_id_t page_id;
+    static_cast<HeaderPage *>(bpm.NewPage(&page_id))->Init();
+    VarlenBPlusTree tree("varlen", &bpm);
+    std::vector<RID> rids;
+    auto encode = [&](int i) {
+      char buffer[VARLEN_KEY_MAX_SIZE];
+      KeyEncoder encoder(buffer, sizeof(buffer));
+      encoder.PutTuple(tuples[i], &key_schema);
+      return std::string(buffer, encoder.GetLength());
+    };
+    run(
+        "varlen", [&](int i) { tree.Insert(encode(i), RID(0, i)); },
+        [&](int i) {
+          rids.clear();
+          tree.GetValue(encode(i), &rids);
+        });
+    page_id_t next_page_id;
+    bpm.UnpinPage(bpm.NewPage(&next_page_id)->GetPageId(), false);
+    std::cout << ", height " << TreeHeight<BPlusTreeVarlenPage<page_id_t>>(&bpm, "varlen") << ", "
+              << next_page_id << " pages" << std::endl;
+    bpm.UnpinPage(HEADER_PAGE_ID, true);
+  }
+  remove("test.db");
+  remove("test.log");
+}
+
+}  // namespace bustub
@@ -0,0 +1,215 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// generic_key_test.cpp
+//
+// Identification: test/storage/generic_key_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/generic_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// Orders key tuples column by column through Value, the way GenericComparator used to. NULLs sort first.
+int CompareValues(const Tuple &lhs, const Tuple &rhs, const Schema *key_schema) {
+  for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+    Value lhs_value = lhs.GetValue(key_schema, i);
+    Value rhs_value = rhs.GetValue(key_schema, i);
+    if (lhs_value.IsNull() || rhs_value.IsNull()) {
+      if (lhs_value.IsNull() != rhs_value.IsNull()) {
+        return lhs_value.IsNull() ? -1 : 1;
+      }
+      continue;
+    }
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      return -1;
+    }
+    if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, SingleColumnOrderTest) {
+  // values of each type in ascending order
+  std::vector<std::pair<TypeId, std::vector<Value>>> columns{
+      {TypeId::BOOLEAN,
+       {ValueFactory::GetNullValueByType(TypeId::BOOLEAN), ValueFactory::GetBooleanValue(false),
+        ValueFactory::GetBooleanValue(true)}},
+      {TypeId::TINYINT,
+       {ValueFactory::GetNullValueByType(TypeId::TINYINT), ValueFactory::GetTinyIntValue(BUSTUB_INT8_MIN),
+        ValueFactory::GetTinyIntValue(-1), ValueFactory::GetTinyIntValue(0), ValueFactory::GetTinyIntValue(1),
+        ValueFactory::GetTinyIntValue(BUSTUB_INT8_MAX)}},
+      {TypeId::SMALLINT,
+       {ValueFactory::GetNullValueByType(TypeId::SMALLINT), ValueFactory::GetSmallIntValue(BUSTUB_INT16_MIN),
+        ValueFactory::GetSmallIntValue(-256), ValueFactory::GetSmallIntValue(-1), ValueFactory::GetSmallIntValue(0),
+        ValueFactory::GetSmallIntValue(255), ValueFactory::GetSmallIntValue(256),
+        ValueFactory::GetSmallIntValue(BUSTUB_INT16_MAX)}},
+      {TypeId::INTEGER,
+       {ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN),
+        ValueFactory::GetIntegerValue(-65536), ValueFactory::GetIntegerValue(-1), ValueFactory::GetIntegerValue(0),
+        ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(65536),
+        ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)}},
+      {TypeId::BIGINT,
+       {ValueFactory::GetNullValueByType(TypeId::BIGINT), ValueFactory::GetBigIntValue(BUSTUB_INT64_MIN),
+        ValueFactory::GetBigIntValue(-(int64_t{1} << 40)), ValueFactory::GetBigIntValue(-1),
+        ValueFactory::GetBigIntValue(0), ValueFactory::GetBigIntValue(1), ValueFactory::GetBigIntValue(int64_t{1} << 40),
+        ValueFactory::GetBigIntValue(BUSTUB_INT64_MAX)}},
+      {TypeId::DECIMAL,
+       {ValueFactory::GetNullValueByType(TypeId::DECIMAL), ValueFactory::GetDecimalValue(-1e300),
+        ValueFactory::GetDecimalValue(-2.5), ValueFactory::GetDecimalValue(-1e-300), ValueFactory::GetDecimalValue(0),
+        ValueFactory::GetDecimalValue(1e-300), ValueFactory::GetDecimalValue(2.5), ValueFactory::GetDecimalValue(1e300)}},
+      {TypeId::VARCHAR,
+       {ValueFactory::GetVarcharValue(""), ValueFactory::GetVarcharValue("a"),
+        ValueFactory::GetVarcharValue(std::string("a\0", 2)), ValueFactory::GetVarcharValue(std::string("a\0b", 3)),
+        ValueFactory::GetVarcharValue("a\x01"), ValueFactory::GetVarcharValue("ab"),
+        ValueFactory::GetVarcharValue("b"), ValueFactory::GetVarcharValue("\xff")}},
+  };
+
+  for (const auto &[type, values] : columns) {
+    Schema key_schema{std::vector<Column>{type == TypeId::VARCHAR ? Column{"a", type, 8} : Column{"a", type}}};
+    GenericComparator<16> comparator(&key_schema);
+    std::vector<GenericKey<16>> keys(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      keys[i].SetFromKey(Tuple{std::vector<Value>{values[i]}, &key_schema}, &key_schema);
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+      for (size_t j = 0; j < keys.size(); j++) {
+        int expected = (i > j) - (i < j);
+        EXPECT_EQ(expected, comparator(keys[i], keys[j])) << Type::TypeIdToString(type) << " " << i << " " << j;
+      }
+    }
+  }
+
+  // -0.0 and 0.0 are the same key
+  Schema key_schema{std::vector<Column>{{"a", TypeId::DECIMAL}}};
+  GenericComparator<8> comparator(&key_schema);
+  GenericKey<8> negative_zero;
+  GenericKey<8> zero;
+  negative_zero.SetFromKey(Tuple{{ValueFactory::GetDecimalValue(-0.0)}, &key_schema}, &key_schema);
+  zero.SetFromKey(Tuple{{ValueFactory::GetDecimalValue(0.0)}, &key_schema}, &key_schema);
+  EXPECT_EQ(0, comparator(negative_zero, zero));
+
+  // the test-only integer keys decode back
+  zero.SetFromInteger(-42);
+  EXPECT_EQ(-42, zero.ToString());
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, MultiColumnOrderTest) {
+  Schema key_schema{std::vector<Column>{{"a", TypeId::SMALLINT}, {"b", TypeId::VARCHAR, 4}, {"c", TypeId::BIGINT}}};
+  GenericComparator<32> comparator(&key_schema);
+
+  // few distinct values per column, so that ties on the leading columns are common
+  std::mt19937 rng(0);
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 200; i++) {
+    std::string b(rng() % 3, 'a');
+    for (auto &c : b) {
+      c = static_cast<char>('a' + rng() % 3);
+    }
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetSmallIntValue(static_cast<int16_t>(rng() % 3) - 1),
+                                           ValueFactory::GetVarcharValue(b),
+                                           ValueFactory::GetBigIntValue(static_cast<int64_t>(rng() % 5) - 2)},
+                        &key_schema);
+  }
+  std::vector<GenericKey<32>> keys(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    keys[i].SetFromKey(tuples[i], &key_schema);
+  }
+  for (size_t i = 0; i < tuples.size(); i++) {
+    for (size_t j = 0; j < tuples.size(); j++) {
+      ASSERT_EQ(CompareValues(tuples[i], tuples[j], &key_schema), comparator(keys[i], keys[j])) << i << " " << j;
+    }
+  }
+}
+
+// Prints the cost of a comparison through Value and through the normalized keys, and the B+ tree lookup
+// throughput on a (INTEGER, VARCHAR, BIGINT) key. Run it with --gtest_also_run_disabled_tests.
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, DISABLED_MultiColumnLookupBenchmark) {
+  Schema key_schema{std::vector<Column>{{"a", TypeId::INTEGER}, {"b", TypeId::VARCHAR, 8}, {"c", TypeId::BIGINT}}};
+  GenericComparator<32> comparator(&key_schema);
+
+  const int64_t num_keys = 1 << 16;
+  std::vector<Tuple> tuples;
+  std::vector<GenericKey<32>> keys(num_keys);
+  for (int64_t i = 0; i < num_keys; i++) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(static_cast<int32_t>(i % 16)),
+                                           ValueFactory::GetVarcharValue("key" + std::to_string(i % 256)),
+                                           ValueFactory::GetBigIntValue(i)},
+                        &key_schema);
+    keys[i].SetFromKey(tuples[i], &key_schema);
+  }
+
+  // a comparison-heavy pass in both representations
+  std::mt19937 rng(0);
+  std::vector<std::pair<int64_t, int64_t>> pairs(1 << 20);
+  for (auto &pair : pairs) {
+    pair = {rng() % num_keys, rng() % num_keys};
+  }
+  auto time_compare = [&](const char *name, auto compare) {
+    int64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &pair : pairs) {
+      sink += compare(pair.first, pair.second);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << ns / pairs.size() << " ns/comparison (" << sink % 2 << ")" << std::endl;
+  };
+  time_compare("Value", [&](int64_t i, int64_t j) { return CompareValues(tuples[i], tuples[j], &key_schema); });
+  time_compare("memcmp", [&](int64_t i, int64_t j) { return comparator(keys[i], keys[j]); });
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(1024, disk_manager);
+  BPlusTree<GenericKey<32>, RID, GenericComparator<32>> tree("foo_pk", bpm, comparator);
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  std::vector<int64_t> order(num_keys);
+  for (int64_t i = 0; i < num_keys; i++) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), rng);
+  for (auto i : order) {
+    tree.Insert(keys[i], RID(0, static_cast<uint32_t>(i)));
+  }
+  std::vector<RID> rids;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < 4; round++) {
+    for (auto i : order) {
+      rids.clear();
+      tree.GetValue(keys[i], &rids);
+      EXPECT_EQ(rids.size(), 1);
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "B+ tree lookup: " << static_cast<int64_t>(4 * num_keys / seconds) << " ops/s" << std::endl;
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+}  // namespace bustub
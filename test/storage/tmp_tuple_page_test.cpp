@@ -19,7 +19,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
+TEST(TmpTuplePageTest, BasicTest) {
   // There are many ways to do this assignment, and this is only one of them.
   // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
   // You will get full credit as long as you are correctly using a linear probe hash table.
@@ -46,6 +46,20 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + PAGE_SIZE - 4), 123);
+  ASSERT_EQ(tmp_tuple, TmpTuple(page_id, PAGE_SIZE - 8));
+
+  Tuple read;
+  page.Get(tmp_tuple, &read);
+  ASSERT_EQ(read.GetValue(&schema, 0).GetAs<int32_t>(), 123);
+  ASSERT_EQ(page.GetNextTupleOffset(tmp_tuple.GetOffset()), PAGE_SIZE);
+
+  // Fill the page up; a tuple takes 8 bytes and the header 12.
+  uint32_t inserted = 1;
+  while (page.Insert(tuple, &tmp_tuple)) {
+    inserted++;
+  }
+  ASSERT_EQ(inserted, (PAGE_SIZE - 12) / 8);
+  ASSERT_EQ(page.GetFreeSpacePointer(), PAGE_SIZE - inserted * 8);
 }
 
 }  // namespace bustub